@@ -4,64 +4,209 @@
 #include "CrosshairHUD.h"
 #include "Engine/Canvas.h"
 #include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/PlayerController.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(CrosshairHUD)
 
+void ACrosshairHUD::BeginPlay()
+{
+    Super::BeginPlay();
+    TargetTraceDelegate.BindUObject(this, &ACrosshairHUD::OnTargetTraceDone);
+}
+
 void ACrosshairHUD::DrawHUD()
 {
     Super::DrawHUD();
 
-    // Get the screen size
-    FVector2D ViewportSize = FVector2D(GEngine->GameViewport->Viewport->GetSizeXY());
-
-    // Calculate crosshair dimensions and center position
-    float CrosshairSize = 10.f;
-    FVector2D CrosshairPosition(ViewportSize.X / 2.f, ViewportSize.Y / 2.f);
-
-    // Calculate dimensions for the inner part of the crosshair
-    float InnerCrosshairSize = CrosshairSize * 0.5f;
-    float InnerCrosshairOffset = InnerCrosshairSize * 0.5f;
-
-    // Line thickness used for drawing the crosshair
-    float LineThickness = 2.f;
-
-    // Draw the outer part of the crosshair horizontally
-    DrawLine(
-       CrosshairPosition.X - CrosshairSize,
-       CrosshairPosition.Y,
-       CrosshairPosition.X + CrosshairSize,
-       CrosshairPosition.Y,
-       FLinearColor::White,
-       LineThickness
-    );
-
-    // Draw the outer part of the crosshair vertically
-    DrawLine(
-       CrosshairPosition.X,
-       CrosshairPosition.Y - CrosshairSize,
-       CrosshairPosition.X,
-       CrosshairPosition.Y + CrosshairSize,
-       FLinearColor::White,
-       LineThickness
-    );
-
-    // Draw the horizontal line representing the inner part of the crosshair
-    DrawLine(
-       CrosshairPosition.X - InnerCrosshairSize - InnerCrosshairOffset,
-       CrosshairPosition.Y,
-       CrosshairPosition.X + InnerCrosshairSize - InnerCrosshairOffset,
-       CrosshairPosition.Y,
-       FLinearColor::Black,
-       LineThickness
-    );
-
-    // Draw the vertical line representing the inner part of the crosshair
-    DrawLine(
-       CrosshairPosition.X,
-       CrosshairPosition.Y - InnerCrosshairSize - InnerCrosshairOffset,
-       CrosshairPosition.X,
-       CrosshairPosition.Y + InnerCrosshairSize - InnerCrosshairOffset,
-       FLinearColor::Black,
-       LineThickness
-    );
+    if (bBatchLocalPlayerCrosshairs && IsPrimaryLocalPlayerHUD())
+    {
+        DrawBatchedCrosshairs();
+        return;
+    }
+
+    // The primary HUD draws this player's crosshair, whichever HUD renders first
+    if (IsDrawnByPrimaryHUD())
+    {
+        return;
+    }
+
+    // Canvas coordinates are relative to this player's view
+    PrepareCrosshair(FVector2D(Canvas->ClipX * 0.5f, Canvas->ClipY * 0.5f), RenderDelta);
+
+    // The whole crosshair is one batched element, drawn from the retained item without copying it
+    Canvas->DrawItem(CrosshairGeometry.GetTriangleItem());
+}
+
+bool ACrosshairHUD::PrepareCrosshair(const FVector2D& Center, float DeltaSeconds)
+{
+    if (bDynamicCrosshair)
+    {
+        UpdateTargetTrace();
+        UpdateDynamicCrosshair(DeltaSeconds);
+    }
+
+    // Vertices are only moved when the center, spread or tint changed since the last frame
+    const bool bGeometryRebuilt = UpdateCrosshairGeometry();
+    return CrosshairGeometry.Layout(Center, CrosshairSpread, CrosshairTint) || bGeometryRebuilt;
+}
+
+bool ACrosshairHUD::IsPrimaryLocalPlayerHUD() const
+{
+    const UGameInstance* GameInstance = GetGameInstance();
+    const ULocalPlayer* LocalPlayer = PlayerOwner ? PlayerOwner->GetLocalPlayer() : nullptr;
+    return GameInstance && LocalPlayer && GameInstance->GetFirstGamePlayer() == LocalPlayer;
+}
+
+bool ACrosshairHUD::IsDrawnByPrimaryHUD() const
+{
+    const UGameInstance* GameInstance = GetGameInstance();
+    const ULocalPlayer* PrimaryPlayer = GameInstance ? GameInstance->GetFirstGamePlayer() : nullptr;
+    const APlayerController* PrimaryController = PrimaryPlayer ? PrimaryPlayer->PlayerController.Get() : nullptr;
+    const ACrosshairHUD* PrimaryHUD = PrimaryController ? Cast<ACrosshairHUD>(PrimaryController->GetHUD()) : nullptr;
+    return PrimaryHUD && PrimaryHUD != this && PrimaryHUD->bShowHUD && PrimaryHUD->bBatchLocalPlayerCrosshairs;
+}
+
+void ACrosshairHUD::UpdatePlayerLayouts()
+{
+    const UGameViewportClient* GameViewport = GetWorld()->GetGameViewport();
+    const UGameInstance* GameInstance = GetGameInstance();
+    if (!GameViewport || !GameInstance)
+    {
+        return;
+    }
+
+    FVector2D ViewportSize;
+    GameViewport->GetViewportSize(ViewportSize);
+
+    // The key only changes on resize, players joining or leaving, or a new split-screen configuration
+    const TArray<ULocalPlayer*>& LocalPlayers = GameInstance->GetLocalPlayers();
+    uint32 LayoutKey = HashCombine(GetTypeHash(ViewportSize), GetTypeHash(LocalPlayers.Num()));
+    for (const ULocalPlayer* LocalPlayer : LocalPlayers)
+    {
+        const APlayerController* Controller = LocalPlayer ? LocalPlayer->PlayerController.Get() : nullptr;
+        LayoutKey = HashCombine(LayoutKey, HashCombine(GetTypeHash(LocalPlayer ? LocalPlayer->Origin : FVector2D::ZeroVector), GetTypeHash(LocalPlayer ? LocalPlayer->Size : FVector2D::ZeroVector)));
+        LayoutKey = HashCombine(LayoutKey, GetTypeHash(Controller ? Controller->GetHUD() : nullptr));
+    }
+    if (LayoutKey == PlayerLayoutKey && PlayerLayouts.Num() > 0)
+    {
+        return;
+    }
+    PlayerLayoutKey = LayoutKey;
+
+    PlayerLayouts.Reset();
+    for (const ULocalPlayer* LocalPlayer : LocalPlayers)
+    {
+        const APlayerController* Controller = LocalPlayer ? LocalPlayer->PlayerController.Get() : nullptr;
+        ACrosshairHUD* PlayerHUD = Controller ? Cast<ACrosshairHUD>(Controller->GetHUD()) : nullptr;
+        if (!PlayerHUD)
+        {
+            continue;
+        }
+
+        // Origin and Size are the player's view rect as a fraction of the viewport
+        const FVector2D ViewOrigin = LocalPlayer->Origin * ViewportSize;
+        const FVector2D ViewSize = LocalPlayer->Size * ViewportSize;
+        PlayerLayouts.Add({ PlayerHUD, ViewOrigin + ViewSize * 0.5f });
+    }
+}
+
+void ACrosshairHUD::DrawBatchedCrosshairs()
+{
+    const uint32 PreviousLayoutKey = PlayerLayoutKey;
+    UpdatePlayerLayouts();
+    bool bBatchDirty = PreviousLayoutKey != PlayerLayoutKey;
+
+    for (const FCrosshairPlayerLayout& Layout : PlayerLayouts)
+    {
+        if (ACrosshairHUD* PlayerHUD = Layout.HUD.Get())
+        {
+            bBatchDirty |= PlayerHUD->PrepareCrosshair(Layout.Center, RenderDelta);
+        }
+    }
+
+    // The batch is only copied again when one of the crosshairs moved
+    TArray<FCanvasUVTri>& BatchedTriangles = BatchedTriangleItem.TriangleList;
+    if (bBatchDirty)
+    {
+        BatchedTriangles.Reset();
+        for (const FCrosshairPlayerLayout& Layout : PlayerLayouts)
+        {
+            if (const ACrosshairHUD* PlayerHUD = Layout.HUD.Get())
+            {
+                BatchedTriangles.Append(PlayerHUD->CrosshairGeometry.GetTriangles());
+            }
+        }
+    }
+
+    // Centers are in viewport pixels, so the draw ignores this player's view offset
+    BatchedTriangleItem.Texture = GWhiteTexture;
+    BatchedTriangleItem.BlendMode = SE_BLEND_Translucent;
+    Canvas->Canvas->PushAbsoluteTransform(FMatrix::Identity);
+    Canvas->DrawItem(BatchedTriangleItem);
+    Canvas->Canvas->PopTransform();
+}
+
+bool ACrosshairHUD::UpdateCrosshairGeometry()
+{
+    const UCrosshairShapeData* Shape = CrosshairShape;
+    const uint32 ShapeVersion = Shape ? Shape->GetVersion() : 0;
+    if (bGeometryBuilt && BuiltShape.Get() == Shape && BuiltShapeVersion == ShapeVersion)
+    {
+        return false;
+    }
+
+    CrosshairGeometry.Build(Shape ? TConstArrayView<FCrosshairElement>(Shape->Elements) : FCrosshairGeometry::GetDefaultElements());
+    BuiltShape = Shape;
+    BuiltShapeVersion = ShapeVersion;
+    bGeometryBuilt = true;
+    return true;
+}
+
+void ACrosshairHUD::UpdateTargetTrace()
+{
+    if (bTargetTracePending || !PlayerOwner)
+    {
+        return;
+    }
+
+    // Each local player traces on its own frame of the interval
+    const ULocalPlayer* LocalPlayer = PlayerOwner->GetLocalPlayer();
+    const uint64 PlayerPhase = LocalPlayer ? LocalPlayer->GetLocalPlayerIndex() : 0;
+    if ((GFrameCounter + PlayerPhase) % FMath::Max(TargetTraceInterval, 1) != 0)
+    {
+        return;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PlayerOwner->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CrosshairTargetTrace));
+    QueryParams.AddIgnoredActor(PlayerOwner->GetPawn());
+
+    GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, ViewLocation, ViewLocation + ViewRotation.Vector() * TargetTraceDistance,
+        TargetTraceChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam, &TargetTraceDelegate);
+    bTargetTracePending = true;
+}
+
+void ACrosshairHUD::OnTargetTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+    bTargetTracePending = false;
+
+    const AActor* HitActor = TraceDatum.OutHits.Num() > 0 ? TraceDatum.OutHits[0].GetActor() : nullptr;
+    const AActor* Viewer = PlayerOwner && PlayerOwner->GetPawn() ? static_cast<const AActor*>(PlayerOwner->GetPawn()) : PlayerOwner.Get();
+    TargetAttitude = HitActor && Viewer ? FGenericTeamId::GetAttitude(Viewer, HitActor) : ETeamAttitude::Neutral;
+}
+
+void ACrosshairHUD::UpdateDynamicCrosshair(float DeltaSeconds)
+{
+    const FLinearColor& TargetColor = TargetAttitude == ETeamAttitude::Hostile ? HostileColor
+       : TargetAttitude == ETeamAttitude::Friendly ? FriendlyColor
+       : NeutralColor;
+
+    // Between traces the values keep easing towards the last result
+    CrosshairSpread = FMath::FInterpTo(CrosshairSpread, TargetSpread, DeltaSeconds, SpreadInterpSpeed);
+    CrosshairTint = FMath::CInterpTo(CrosshairTint, TargetColor, DeltaSeconds, ColorInterpSpeed);
 }
\ No newline at end of file
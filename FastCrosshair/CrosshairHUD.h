@@ -4,10 +4,19 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/HUD.h"
+#include "CrosshairShapeData.h"
+#include "WorldCollision.h"
+#include "GenericTeamAgentInterface.h"
 #include "CrosshairHUD.generated.h"
 
 /**
- * 
+ * Draws the crosshair as retained geometry: the shape is triangulated once and sent as a single canvas triangle item.
+ * The vertices only move when the viewport size, spread or tint change.
+ * With bDynamicCrosshair the spread follows the weapon spread and the tint follows the attitude of the aimed actor.
+ * The aimed actor is found by an async camera trace issued every TargetTraceInterval frames, values are interpolated in between.
+ * Drawing sends retained canvas triangle items whose vertices are updated in place, so the draw itself neither copies nor
+ * allocates the triangle arrays. The only scene query is the async target trace, and it is never waited on.
+ * In split-screen every crosshair is centered on its player's view, and the first local player's HUD draws all of them in one item.
  */
 UCLASS()
 class GAME_API ACrosshairHUD : public AHUD
@@ -15,6 +24,132 @@ class GAME_API ACrosshairHUD : public AHUD
 	GENERATED_BODY()
 
 public:
+	// AActor Interface
+	virtual void BeginPlay() override;
+
 	// AHUD Interface
 	virtual void DrawHUD() override;
+
+	/**
+	 * Sets the spread the crosshair widens towards
+	 * @param Spread - Weapon spread in crosshair pixels
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Crosshair")
+	void SetTargetSpread(float Spread) { TargetSpread = Spread; }
+
+	/** Shape of the crosshair, the original white and black cross is used when empty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	TObjectPtr<UCrosshairShapeData> CrosshairShape;
+
+	/** Distance in pixels the elements move apart, see FCrosshairElement::SpreadDirection */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	float CrosshairSpread = 0.f;
+
+	/** Multiplied with the color of every element */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	FLinearColor CrosshairTint = FLinearColor::White;
+
+	/** If true, CrosshairSpread and CrosshairTint are driven by the weapon spread and the aimed actor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic")
+	bool bDynamicCrosshair = true;
+
+	/** Frames between two target traces, local players are staggered so they don't trace on the same frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic", meta = (ClampMin = "1"))
+	int32 TargetTraceInterval = 4;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic")
+	float TargetTraceDistance = 10000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic")
+	TEnumAsByte<ECollisionChannel> TargetTraceChannel = ECC_Visibility;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic")
+	FLinearColor NeutralColor = FLinearColor::White;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic")
+	FLinearColor FriendlyColor = FLinearColor::Green;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic")
+	FLinearColor HostileColor = FLinearColor::Red;
+
+	/** Interpolation speeds towards the target spread and color */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic")
+	float SpreadInterpSpeed = 12.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Dynamic")
+	float ColorInterpSpeed = 10.f;
+
+	/** If true, the first local player's HUD draws the crosshairs of every local player in one canvas item */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair|Split Screen")
+	bool bBatchLocalPlayerCrosshairs = true;
+
+private:
+	/** Crosshair center of one local player in viewport pixels */
+	struct FCrosshairPlayerLayout
+	{
+		TWeakObjectPtr<ACrosshairHUD> HUD;
+		FVector2D Center;
+	};
+
+	/**
+	 * Updates the dynamic values and places the crosshair
+	 * @param Center - Crosshair center, in the coordinates it is drawn in
+	 * @param DeltaSeconds - Time since the last frame
+	 * @return True if the vertices moved
+	 */
+	bool PrepareCrosshair(const FVector2D& Center, float DeltaSeconds);
+
+	/** Recomputes the per-player centers if the viewport size or the split-screen layout changed */
+	void UpdatePlayerLayouts();
+
+	/** True if this HUD belongs to the first local player */
+	bool IsPrimaryLocalPlayerHUD() const;
+
+	/** True if the first local player's HUD batches the crosshairs and draws this one, secondary HUDs then never draw themselves */
+	bool IsDrawnByPrimaryHUD() const;
+
+	/** Draws the crosshair of every local player in one item, primary HUD only */
+	void DrawBatchedCrosshairs();
+
+	/** Per-player centers, primary HUD only */
+	TArray<FCrosshairPlayerLayout, TInlineAllocator<4>> PlayerLayouts;
+
+	/** Hash of the viewport size and player view rects the layouts were computed for */
+	uint32 PlayerLayoutKey = 0;
+
+	/** Triangles of every local player's crosshair, rebuilt in place when one of them moved, primary HUD only */
+	FCanvasTriangleItem BatchedTriangleItem{ TArray<FCanvasUVTri>(), nullptr };
+
+	/** Issues the async target trace on this player's frames */
+	void UpdateTargetTrace();
+
+	/** Stores the attitude of the aimed actor, called on the game thread the frame after the trace */
+	void OnTargetTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** Moves the spread and tint towards their targets */
+	void UpdateDynamicCrosshair(float DeltaSeconds);
+
+	/** Bound once, the trace copies it */
+	FTraceDelegate TargetTraceDelegate;
+
+	/** Spread set by the weapon */
+	float TargetSpread = 0.f;
+
+	/** Attitude of the actor under the crosshair at the last trace */
+	ETeamAttitude::Type TargetAttitude = ETeamAttitude::Neutral;
+
+	bool bTargetTracePending = false;
+
+	/**
+	 * Triangulates the shape again if the asset or its version changed
+	 * @return True if the geometry was rebuilt
+	 */
+	bool UpdateCrosshairGeometry();
+
+	FCrosshairGeometry CrosshairGeometry;
+
+	/** Shape and version the geometry was built from */
+	TWeakObjectPtr<const UCrosshairShapeData> BuiltShape;
+	uint32 BuiltShapeVersion = 0;
+	bool bGeometryBuilt = false;
 };
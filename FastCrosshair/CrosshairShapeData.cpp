@@ -0,0 +1,140 @@
+// Copyright (C) Thyke. All Rights Reserved.
+
+
+#include "CrosshairShapeData.h"
+#include "RenderUtils.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(CrosshairShapeData)
+
+#if WITH_EDITOR
+void UCrosshairShapeData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    ++Version;
+}
+#endif
+
+TConstArrayView<FCrosshairElement> FCrosshairGeometry::GetDefaultElements()
+{
+    static const TArray<FCrosshairElement> DefaultElements = []()
+    {
+        auto MakeLine = [](const FVector2D& Start, const FVector2D& End, const FLinearColor& Color)
+        {
+            FCrosshairElement Element;
+            Element.Start = Start;
+            Element.End = End;
+            Element.Color = Color;
+            return Element;
+        };
+
+        // Outer cross of size 10, inner cross of size 5 shifted by half its size
+        return TArray<FCrosshairElement>{
+            MakeLine(FVector2D(-10.f, 0.f), FVector2D(10.f, 0.f), FLinearColor::White),
+            MakeLine(FVector2D(0.f, -10.f), FVector2D(0.f, 10.f), FLinearColor::White),
+            MakeLine(FVector2D(-7.5f, 0.f), FVector2D(2.5f, 0.f), FLinearColor::Black),
+            MakeLine(FVector2D(0.f, -7.5f), FVector2D(0.f, 2.5f), FLinearColor::Black)
+        };
+    }();
+    return DefaultElements;
+}
+
+void FCrosshairGeometry::AddQuad(const FLocalVertex& A, const FLocalVertex& B, const FLocalVertex& C, const FLocalVertex& D)
+{
+    LocalVertices.Add(A);
+    LocalVertices.Add(B);
+    LocalVertices.Add(C);
+    LocalVertices.Add(A);
+    LocalVertices.Add(C);
+    LocalVertices.Add(D);
+}
+
+void FCrosshairGeometry::Build(TConstArrayView<FCrosshairElement> Elements)
+{
+    LocalVertices.Reset();
+
+    for (const FCrosshairElement& Element : Elements)
+    {
+        const FVector2D SpreadOffset = Element.SpreadDirection;
+        switch (Element.Type)
+        {
+        case ECrosshairElementType::Line:
+        {
+            const FVector2D Direction = (Element.End - Element.Start).GetSafeNormal();
+            const FVector2D Side = FVector2D(-Direction.Y, Direction.X) * (Element.Thickness * 0.5f);
+            AddQuad(
+                { Element.Start - Side, SpreadOffset, Element.Color },
+                { Element.End - Side, SpreadOffset, Element.Color },
+                { Element.End + Side, SpreadOffset, Element.Color },
+                { Element.Start + Side, SpreadOffset, Element.Color });
+            break;
+        }
+        case ECrosshairElementType::Dot:
+        {
+            const int32 Segments = FMath::Max(Element.Segments, 3);
+            for (int32 Segment = 0; Segment < Segments; ++Segment)
+            {
+                const float Angle0 = UE_TWO_PI * Segment / Segments;
+                const float Angle1 = UE_TWO_PI * (Segment + 1) / Segments;
+                LocalVertices.Add({ Element.Start, SpreadOffset, Element.Color });
+                LocalVertices.Add({ Element.Start + FVector2D(FMath::Cos(Angle0), FMath::Sin(Angle0)) * Element.Radius, SpreadOffset, Element.Color });
+                LocalVertices.Add({ Element.Start + FVector2D(FMath::Cos(Angle1), FMath::Sin(Angle1)) * Element.Radius, SpreadOffset, Element.Color });
+            }
+            break;
+        }
+        case ECrosshairElementType::Arc:
+        {
+            // Arc vertices move along their own radius, so the spread grows the circle instead of shifting it
+            const int32 Segments = FMath::Max(Element.Segments, 1);
+            const float InnerRadius = Element.Radius - Element.Thickness * 0.5f;
+            const float OuterRadius = Element.Radius + Element.Thickness * 0.5f;
+            for (int32 Segment = 0; Segment < Segments; ++Segment)
+            {
+                const float Angle0 = FMath::DegreesToRadians(FMath::Lerp(Element.StartAngle, Element.EndAngle, static_cast<float>(Segment) / Segments));
+                const float Angle1 = FMath::DegreesToRadians(FMath::Lerp(Element.StartAngle, Element.EndAngle, static_cast<float>(Segment + 1) / Segments));
+                const FVector2D Dir0(FMath::Cos(Angle0), FMath::Sin(Angle0));
+                const FVector2D Dir1(FMath::Cos(Angle1), FMath::Sin(Angle1));
+                AddQuad(
+                    { Element.Start + Dir0 * InnerRadius, Dir0 * SpreadOffset.X, Element.Color },
+                    { Element.Start + Dir0 * OuterRadius, Dir0 * SpreadOffset.X, Element.Color },
+                    { Element.Start + Dir1 * OuterRadius, Dir1 * SpreadOffset.X, Element.Color },
+                    { Element.Start + Dir1 * InnerRadius, Dir1 * SpreadOffset.X, Element.Color });
+            }
+            break;
+        }
+        }
+    }
+
+    TriangleItem.TriangleList.SetNum(LocalVertices.Num() / 3);
+    TriangleItem.Texture = GWhiteTexture;
+    TriangleItem.BlendMode = SE_BLEND_Translucent;
+    bLayoutValid = false;
+}
+
+bool FCrosshairGeometry::Layout(const FVector2D& Center, float Spread, const FLinearColor& Tint)
+{
+    if (bLayoutValid && Center == LayoutCenter && Spread == LayoutSpread && Tint == LayoutTint)
+    {
+        return false;
+    }
+
+    // Only positions and colors change, the triangle array keeps its size
+    TArray<FCanvasUVTri>& ScreenTriangles = TriangleItem.TriangleList;
+    for (int32 TriangleIndex = 0; TriangleIndex < ScreenTriangles.Num(); ++TriangleIndex)
+    {
+        const FLocalVertex* Vertices = &LocalVertices[TriangleIndex * 3];
+        FCanvasUVTri& Triangle = ScreenTriangles[TriangleIndex];
+        Triangle.V0_Pos = Center + Vertices[0].Position + Vertices[0].SpreadOffset * Spread;
+        Triangle.V1_Pos = Center + Vertices[1].Position + Vertices[1].SpreadOffset * Spread;
+        Triangle.V2_Pos = Center + Vertices[2].Position + Vertices[2].SpreadOffset * Spread;
+        Triangle.V0_Color = Vertices[0].Color * Tint;
+        Triangle.V1_Color = Vertices[1].Color * Tint;
+        Triangle.V2_Color = Vertices[2].Color * Tint;
+        Triangle.V0_UV = Triangle.V1_UV = Triangle.V2_UV = FVector2D::ZeroVector;
+    }
+
+    LayoutCenter = Center;
+    LayoutSpread = Spread;
+    LayoutTint = Tint;
+    bLayoutValid = true;
+    return true;
+}
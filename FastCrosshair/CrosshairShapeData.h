@@ -0,0 +1,142 @@
+// Copyright (C) Thyke. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "CanvasTypes.h"
+#include "CanvasItem.h"
+#include "CrosshairShapeData.generated.h"
+
+UENUM(BlueprintType)
+enum class ECrosshairElementType : uint8
+{
+	Line,
+	Dot,
+	Arc
+};
+
+/**
+ * One primitive of a crosshair, in pixels relative to the crosshair center
+ */
+USTRUCT(BlueprintType)
+struct FCrosshairElement
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	ECrosshairElementType Type = ECrosshairElementType::Line;
+
+	/** Line start, or center of a dot or arc */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	FVector2D Start = FVector2D::ZeroVector;
+
+	/** Line end */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair", meta = (EditCondition = "Type == ECrosshairElementType::Line"))
+	FVector2D End = FVector2D::ZeroVector;
+
+	/** Radius of a dot or arc */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair", meta = (EditCondition = "Type != ECrosshairElementType::Line"))
+	float Radius = 2.f;
+
+	/** Arc angles in degrees, 0 points right and angles grow clockwise */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair", meta = (EditCondition = "Type == ECrosshairElementType::Arc"))
+	float StartAngle = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair", meta = (EditCondition = "Type == ECrosshairElementType::Arc"))
+	float EndAngle = 360.f;
+
+	/** Number of segments of a dot or arc */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair", meta = (EditCondition = "Type != ECrosshairElementType::Line", ClampMin = "3"))
+	int32 Segments = 12;
+
+	/** Width of a line or arc */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair", meta = (EditCondition = "Type != ECrosshairElementType::Dot"))
+	float Thickness = 2.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	FLinearColor Color = FLinearColor::White;
+
+	/** How the element moves with the crosshair spread: lines and dots are offset by Spread * SpreadDirection, arcs grow their radius by Spread * SpreadDirection.X */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Crosshair")
+	FVector2D SpreadDirection = FVector2D::ZeroVector;
+};
+
+/**
+ * Crosshair shape made of lines, dots and arc segments
+ */
+UCLASS(BlueprintType)
+class GAME_API UCrosshairShapeData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Incremented on every edit so HUDs rebuild their retained geometry */
+	FORCEINLINE uint32 GetVersion() const { return Version; }
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Crosshair")
+	TArray<FCrosshairElement> Elements;
+
+private:
+	uint32 Version = 0;
+};
+
+/**
+ * Retained crosshair triangles, sent to the canvas as one triangle item
+ * Build triangulates the shape once, Layout only moves the vertices when the center, spread or tint change.
+ */
+struct GAME_API FCrosshairGeometry
+{
+	/**
+	 * Triangulates a shape around the origin
+	 * @param Elements - Elements of the shape
+	 */
+	void Build(TConstArrayView<FCrosshairElement> Elements);
+
+	/**
+	 * Places the triangles on screen, does nothing if nothing changed since the last call
+	 * @param Center - Crosshair center in canvas pixels
+	 * @param Spread - Spread in pixels
+	 * @param Tint - Multiplied with the element colors
+	 * @return True if the vertices moved
+	 */
+	bool Layout(const FVector2D& Center, float Spread, const FLinearColor& Tint);
+
+	/** Marks the layout dirty, the next Layout call moves every vertex */
+	FORCEINLINE void Invalidate() { bLayoutValid = false; }
+
+	/** Screen-space triangles of the last Layout */
+	FORCEINLINE const TArray<FCanvasUVTri>& GetTriangles() const { return TriangleItem.TriangleList; }
+
+	/** Canvas item holding the triangles, drawn as is every frame */
+	FORCEINLINE FCanvasTriangleItem& GetTriangleItem() { return TriangleItem; }
+
+	/** Crosshair made of the original white cross with a black inner cross */
+	static TConstArrayView<FCrosshairElement> GetDefaultElements();
+
+private:
+	/** Vertex around the origin and the direction it moves with the spread */
+	struct FLocalVertex
+	{
+		FVector2D Position;
+		FVector2D SpreadOffset;
+		FLinearColor Color;
+	};
+
+	void AddQuad(const FLocalVertex& A, const FLocalVertex& B, const FLocalVertex& C, const FLocalVertex& D);
+
+	/** Three vertices per triangle */
+	TArray<FLocalVertex> LocalVertices;
+
+	/** Owns the screen-space triangles, Layout writes them in place so drawing never copies them */
+	FCanvasTriangleItem TriangleItem{ TArray<FCanvasUVTri>(), nullptr };
+
+	FVector2D LayoutCenter = FVector2D::ZeroVector;
+	float LayoutSpread = 0.f;
+	FLinearColor LayoutTint = FLinearColor::White;
+	bool bLayoutValid = false;
+};
@@ -0,0 +1,378 @@
+﻿// Kalabalık ayak sesi maliyetini ölçen başsız (headless) benchmark.
+/**
+@ Thyke
+*/
+
+
+#include "FootStepBenchmarkGameMode.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace FootStepBenchmark
+{
+    static const TCHAR* GetModeName(EFootStepMode Mode)
+    {
+        switch (Mode)
+        {
+        case EFootStepMode::SyncTrace: return TEXT("SyncTrace");
+        case EFootStepMode::AsyncTrace: return TEXT("AsyncTrace");
+        case EFootStepMode::MovementFloor: return TEXT("MovementFloor");
+        case EFootStepMode::MovementFloorCrowd: return TEXT("MovementFloorCrowd");
+        default: return TEXT("NotifySettings");
+        }
+    }
+
+    // Her şeyi önceki GMalloc'a iletir ve yalnızca oyun thread'inin tahsislerini sayar,
+    // arka plandaki motor thread'leri (akış, ses, render) sonuçlara karışmaz
+    class FGameThreadCountingMalloc final : public FMalloc
+    {
+    public:
+        FGameThreadCountingMalloc(FMalloc* InInner, uint32 InThreadId)
+            : Inner(InInner)
+            , ThreadId(InThreadId)
+        {
+        }
+
+        void Reset()
+        {
+            Allocations.store(0, std::memory_order_relaxed);
+            Bytes.store(0, std::memory_order_relaxed);
+        }
+
+        int64 GetAllocations() const { return Allocations.load(std::memory_order_relaxed); }
+        int64 GetBytes() const { return Bytes.load(std::memory_order_relaxed); }
+        FMalloc* GetInner() const { return Inner; }
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            RecordAllocation(Count);
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            RecordAllocation(Count);
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            RecordAllocation(Count);
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            RecordAllocation(Count);
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void UpdateStats() override { Inner->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+    private:
+        void RecordAllocation(SIZE_T Size)
+        {
+            if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+            {
+                Allocations.fetch_add(1, std::memory_order_relaxed);
+                Bytes.fetch_add(static_cast<int64>(Size), std::memory_order_relaxed);
+            }
+        }
+
+        FMalloc* Inner;
+        uint32 ThreadId;
+        std::atomic<int64> Allocations{ 0 };
+        std::atomic<int64> Bytes{ 0 };
+    };
+
+    // Hiç silinmez, ölçüm sırasında tahsis edilen bellek sonradan onun üzerinden serbest bırakılabilir
+    static FGameThreadCountingMalloc* CountingMalloc = nullptr;
+
+    // Ölçüm penceresinin başında GMalloc'u sayaçla sarar
+    static void BeginCountingAllocations()
+    {
+        if (!CountingMalloc)
+        {
+            CountingMalloc = new FGameThreadCountingMalloc(GMalloc, FPlatformTLS::GetCurrentThreadId());
+        }
+        CountingMalloc->Reset();
+        GMalloc = CountingMalloc;
+    }
+
+    // Ölçüm penceresinin sonunda önceki GMalloc'u geri koyar
+    static void EndCountingAllocations(int64& OutAllocations, int64& OutBytes)
+    {
+        OutAllocations = CountingMalloc ? CountingMalloc->GetAllocations() : 0;
+        OutBytes = CountingMalloc ? CountingMalloc->GetBytes() : 0;
+        if (CountingMalloc && GMalloc == CountingMalloc)
+        {
+            GMalloc = CountingMalloc->GetInner();
+        }
+    }
+
+    static void SetFootStepMode(EFootStepMode Mode)
+    {
+        if (IConsoleVariable* ModeVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("FootStep.Mode")))
+        {
+            ModeVariable->Set(static_cast<int32>(Mode), ECVF_SetByCode);
+        }
+    }
+}
+
+AFootStepBenchmarkGameMode::AFootStepBenchmarkGameMode()
+{
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = true;
+}
+
+void AFootStepBenchmarkGameMode::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Komut satırı ayarları config değerlerini geçersiz kılar
+    const TCHAR* CommandLine = FCommandLine::Get();
+    FParse::Value(CommandLine, TEXT("FootStepCharacters="), NumCharacters);
+    FParse::Value(CommandLine, TEXT("FootStepWarmup="), WarmupSeconds);
+    FParse::Value(CommandLine, TEXT("FootStepSeconds="), MeasureSeconds);
+    FParse::Value(CommandLine, TEXT("FootStepSeed="), RandomSeed);
+
+    FString ModeList = TEXT("1,2,3,4");
+    FParse::Value(CommandLine, TEXT("FootStepModes="), ModeList);
+    TArray<FString> ModeNames;
+    ModeList.ParseIntoArray(ModeNames, TEXT(","));
+    for (const FString& ModeName : ModeNames)
+    {
+        const int32 Mode = FCString::Atoi(*ModeName);
+        if (Mode >= 0 && Mode < static_cast<int32>(EFootStepMode::Count))
+        {
+            Modes.Add(static_cast<EFootStepMode>(Mode));
+        }
+    }
+
+    SpawnCharacters();
+    GUObjectArray.AddUObjectCreateListener(this);
+    BeginMode(0);
+}
+
+void AFootStepBenchmarkGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    // Ölçüm yarıda kalırsa GMalloc geri alınır
+    int64 Allocations = 0;
+    int64 Bytes = 0;
+    FootStepBenchmark::EndCountingAllocations(Allocations, Bytes);
+    bMeasuring = false;
+
+    GUObjectArray.RemoveUObjectCreateListener(this);
+    Super::EndPlay(EndPlayReason);
+}
+
+void AFootStepBenchmarkGameMode::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+    if (bMeasuring.load(std::memory_order_relaxed))
+    {
+        UObjectsCreated.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void AFootStepBenchmarkGameMode::OnUObjectArrayShutdown()
+{
+    GUObjectArray.RemoveUObjectCreateListener(this);
+}
+
+void AFootStepBenchmarkGameMode::SpawnCharacters()
+{
+    UClass* SpawnClass = CharacterClass.LoadSynchronous();
+    if (!SpawnClass)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FootStep benchmark: CharacterClass is not set"));
+        return;
+    }
+
+    // Karakterler oyun modunun konumu etrafında kare bir ızgaraya dizilir, böylece harita yüzeylerine yayılırlar
+    const int32 Columns = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumCharacters))));
+    const FVector Origin = GetActorLocation() - FVector(Columns * CharacterSpacing * 0.5f, Columns * CharacterSpacing * 0.5f, 0.0f);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+    FRandomStream Random(RandomSeed);
+    for (int32 Index = 0; Index < NumCharacters; ++Index)
+    {
+        const FVector Location = Origin + FVector((Index % Columns) * CharacterSpacing, (Index / Columns) * CharacterSpacing, 0.0f);
+        ACharacter* Character = GetWorld()->SpawnActor<ACharacter>(SpawnClass, Location, FRotator(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f), SpawnParams);
+        if (!Character)
+        {
+            continue;
+        }
+
+        // -nullrhi ile hiçbir şey görünmez, animasyonlar yine de her frame güncellenmeli
+        Character->GetMesh()->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+        if (!Character->GetController())
+        {
+            Character->SpawnDefaultController();
+        }
+        Characters.Add(Character);
+    }
+}
+
+void AFootStepBenchmarkGameMode::DriveCharacters(float DeltaSeconds)
+{
+    // Her karakter kendi yönünde yavaşça dönerek yürür, böylece ızgaradan fazla uzaklaşmaz
+    for (ACharacter* Character : Characters)
+    {
+        if (Character)
+        {
+            Character->AddActorWorldRotation(FRotator(0.0f, 20.0f * DeltaSeconds, 0.0f));
+            Character->AddMovementInput(Character->GetActorForwardVector());
+        }
+    }
+}
+
+void AFootStepBenchmarkGameMode::BeginMode(int32 ModeIndex)
+{
+    CurrentModeIndex = ModeIndex;
+    if (!Modes.IsValidIndex(ModeIndex))
+    {
+        WriteResults();
+        FPlatformMisc::RequestExit(false);
+        return;
+    }
+
+    FootStepBenchmark::SetFootStepMode(Modes[ModeIndex]);
+    ModeStartTime = FPlatformTime::Seconds();
+    bMeasuring = false;
+}
+
+void AFootStepBenchmarkGameMode::Tick(float DeltaSeconds)
+{
+    Super::Tick(DeltaSeconds);
+
+    if (!Modes.IsValidIndex(CurrentModeIndex))
+    {
+        return;
+    }
+    DriveCharacters(DeltaSeconds);
+
+    const double Elapsed = FPlatformTime::Seconds() - ModeStartTime;
+    if (!bMeasuring)
+    {
+        if (Elapsed < WarmupSeconds)
+        {
+            return;
+        }
+
+        StartCounters = FFootStepCounters::Get();
+        GameThreadMsSum = 0.0;
+        GameThreadMsMax = 0.0;
+        MeasuredFrames = 0;
+        UObjectsCreated.store(0);
+        FootStepBenchmark::BeginCountingAllocations();
+        bMeasuring = true;
+        return;
+    }
+
+    // GGameThreadTime bir önceki frame'in oyun thread süresidir
+    const double GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+    GameThreadMsSum += GameThreadMs;
+    GameThreadMsMax = FMath::Max(GameThreadMsMax, GameThreadMs);
+    ++MeasuredFrames;
+
+    if (Elapsed >= WarmupSeconds + MeasureSeconds)
+    {
+        FinishMode();
+        BeginMode(CurrentModeIndex + 1);
+    }
+}
+
+void AFootStepBenchmarkGameMode::FinishMode()
+{
+    bMeasuring = false;
+    int64 GameThreadAllocations = 0;
+    int64 GameThreadAllocatedBytes = 0;
+    FootStepBenchmark::EndCountingAllocations(GameThreadAllocations, GameThreadAllocatedBytes);
+
+    const FFootStepCounters& Counters = FFootStepCounters::Get();
+    const double Frames = FMath::Max(MeasuredFrames, 1);
+
+    FFootStepBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+    Result.Mode = Modes[CurrentModeIndex];
+    Result.NumFrames = MeasuredFrames;
+    Result.AvgGameThreadMs = GameThreadMsSum / Frames;
+    Result.MaxGameThreadMs = GameThreadMsMax;
+    Result.SceneQueriesPerFrame = ((Counters.SyncTraces - StartCounters.SyncTraces) + (Counters.AsyncTraces - StartCounters.AsyncTraces)) / Frames;
+    Result.FloorResolvesPerFrame = (Counters.FloorResolves - StartCounters.FloorResolves) / Frames;
+    Result.NotifiesPerFrame = (Counters.Notifies - StartCounters.Notifies) / Frames;
+    Result.NiagaraActivations = Counters.NiagaraActivations - StartCounters.NiagaraActivations;
+    Result.NiagaraComponentsCreated = Counters.NiagaraComponentsCreated - StartCounters.NiagaraComponentsCreated;
+    Result.SoundsPlayed = Counters.SoundsPlayed - StartCounters.SoundsPlayed;
+    Result.UObjectsCreated = UObjectsCreated.load();
+    Result.GameThreadAllocations = GameThreadAllocations;
+    Result.GameThreadAllocatedBytes = GameThreadAllocatedBytes;
+
+    UE_LOG(LogTemp, Display, TEXT("FootStep benchmark %s: %.3f ms game thread, %.1f queries/frame, %lld niagara, %lld uobjects, %lld game thread allocations"),
+        FootStepBenchmark::GetModeName(Result.Mode), Result.AvgGameThreadMs, Result.SceneQueriesPerFrame, Result.NiagaraActivations, Result.UObjectsCreated,
+        Result.GameThreadAllocations);
+}
+
+void AFootStepBenchmarkGameMode::WriteResults() const
+{
+    const FString BaseName = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("FootStepBenchmark_%s"), *FDateTime::Now().ToString());
+
+    FString Csv = TEXT("mode,characters,frames,avg_game_thread_ms,max_game_thread_ms,scene_queries_per_frame,floor_resolves_per_frame,notifies_per_frame,niagara_activations,niagara_components_created,sounds_played,uobjects_created,game_thread_allocations,game_thread_allocated_bytes\n");
+    TArray<TSharedPtr<FJsonValue>> JsonResults;
+    for (const FFootStepBenchmarkResult& Result : Results)
+    {
+        Csv += FString::Printf(TEXT("%s,%d,%d,%.4f,%.4f,%.3f,%.3f,%.3f,%lld,%lld,%lld,%lld,%lld,%lld\n"),
+            FootStepBenchmark::GetModeName(Result.Mode), Characters.Num(), Result.NumFrames, Result.AvgGameThreadMs, Result.MaxGameThreadMs,
+            Result.SceneQueriesPerFrame, Result.FloorResolvesPerFrame, Result.NotifiesPerFrame, Result.NiagaraActivations,
+            Result.NiagaraComponentsCreated, Result.SoundsPlayed, Result.UObjectsCreated, Result.GameThreadAllocations,
+            Result.GameThreadAllocatedBytes);
+
+        TSharedRef<FJsonObject> JsonResult = MakeShared<FJsonObject>();
+        JsonResult->SetStringField(TEXT("mode"), FootStepBenchmark::GetModeName(Result.Mode));
+        JsonResult->SetNumberField(TEXT("characters"), Characters.Num());
+        JsonResult->SetNumberField(TEXT("frames"), Result.NumFrames);
+        JsonResult->SetNumberField(TEXT("avg_game_thread_ms"), Result.AvgGameThreadMs);
+        JsonResult->SetNumberField(TEXT("max_game_thread_ms"), Result.MaxGameThreadMs);
+        JsonResult->SetNumberField(TEXT("scene_queries_per_frame"), Result.SceneQueriesPerFrame);
+        JsonResult->SetNumberField(TEXT("floor_resolves_per_frame"), Result.FloorResolvesPerFrame);
+        JsonResult->SetNumberField(TEXT("notifies_per_frame"), Result.NotifiesPerFrame);
+        JsonResult->SetNumberField(TEXT("niagara_activations"), Result.NiagaraActivations);
+        JsonResult->SetNumberField(TEXT("niagara_components_created"), Result.NiagaraComponentsCreated);
+        JsonResult->SetNumberField(TEXT("sounds_played"), Result.SoundsPlayed);
+        JsonResult->SetNumberField(TEXT("uobjects_created"), Result.UObjectsCreated);
+        JsonResult->SetNumberField(TEXT("game_thread_allocations"), Result.GameThreadAllocations);
+        JsonResult->SetNumberField(TEXT("game_thread_allocated_bytes"), Result.GameThreadAllocatedBytes);
+        JsonResults.Add(MakeShared<FJsonValueObject>(JsonResult));
+    }
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetArrayField(TEXT("results"), JsonResults);
+    FJsonSerializer::Serialize(Root, Writer);
+
+    FFileHelper::SaveStringToFile(Csv, *(BaseName + TEXT(".csv")));
+    FFileHelper::SaveStringToFile(Json, *(BaseName + TEXT(".json")));
+    UE_LOG(LogTemp, Display, TEXT("FootStep benchmark results written to %s.csv/.json"), *BaseName);
+}
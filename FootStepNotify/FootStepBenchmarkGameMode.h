@@ -0,0 +1,112 @@
+﻿// Kalabalık ayak sesi maliyetini ölçen başsız (headless) benchmark.
+/**
+@ Thyke
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "UObject/UObjectArray.h"
+#include "FootStepNotify.h"
+#include <atomic>
+#include "FootStepBenchmarkGameMode.generated.h"
+
+class ACharacter;
+
+// Bir modun ölçüm sonucu
+struct FFootStepBenchmarkResult
+{
+	EFootStepMode Mode = EFootStepMode::NotifySettings;
+	int32 NumFrames = 0;
+	double AvgGameThreadMs = 0.0;
+	double MaxGameThreadMs = 0.0;
+	double SceneQueriesPerFrame = 0.0;
+	double FloorResolvesPerFrame = 0.0;
+	double NotifiesPerFrame = 0.0;
+	int64 NiagaraActivations = 0;
+	int64 NiagaraComponentsCreated = 0;
+	int64 SoundsPlayed = 0;
+	int64 UObjectsCreated = 0;
+
+	// Ölçüm sırasında oyun thread'inde yapılan bellek tahsisleri (GMalloc üzerinden)
+	int64 GameThreadAllocations = 0;
+	int64 GameThreadAllocatedBytes = 0;
+};
+
+// FootStepBenchmarkGameMode - N karakter oluşturur, onları sürekli yürütür ve her FootStep.Mode için maliyeti ölçer.
+// Linux'ta başsız çalıştırmak için:
+//   EternityServer / UnrealEditor-Cmd <Proje> <TestHaritası>?game=/Script/Eternity.FootStepBenchmarkGameMode -game -nullrhi -nosound -unattended
+//   -FootStepCharacters=300 -FootStepModes=1,2,3,4 -FootStepWarmup=3 -FootStepSeconds=10 -FootStepSeed=24301
+// Harita farklı fiziksel yüzeylere sahip bir zemin içermeli, CharacterClass'ın animasyonları FootStepNotify tetiklemelidir.
+// Sonuçlar Saved/Benchmarks altına CSV ve JSON olarak yazılır ve oyun kapanır; dosyalar sürümler arasında karşılaştırılabilir.
+UCLASS(Config = Game)
+class ETERNITY_API AFootStepBenchmarkGameMode : public AGameModeBase, public FUObjectArray::FUObjectCreateListener
+{
+	GENERATED_BODY()
+
+public:
+	AFootStepBenchmarkGameMode();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Tick(float DeltaSeconds) override;
+
+	// FUObjectCreateListener Interface
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+
+	// Oluşturulacak karakter sınıfı, animasyonu FootStepNotify içermeli
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Benchmark")
+	TSoftClassPtr<ACharacter> CharacterClass;
+
+	// Oluşturulacak karakter sayısı (-FootStepCharacters=)
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Benchmark")
+	int32 NumCharacters = 300;
+
+	// Karakterlerin ızgarada aralarındaki mesafe (cm)
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Benchmark")
+	float CharacterSpacing = 250.0f;
+
+	// Her moddan önce ölçülmeyen ısınma süresi (-FootStepWarmup=)
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Benchmark")
+	float WarmupSeconds = 3.0f;
+
+	// Her modun ölçüm süresi (-FootStepSeconds=)
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Benchmark")
+	float MeasureSeconds = 10.0f;
+
+	// Karakterlerin başlangıç yönlerinin tohumu, aynı tohumla koşular karşılaştırılabilir (-FootStepSeed=)
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Benchmark")
+	int32 RandomSeed = 0x5EED;
+
+private:
+	void SpawnCharacters();
+	void DriveCharacters(float DeltaSeconds);
+	void BeginMode(int32 ModeIndex);
+	void FinishMode();
+	void WriteResults() const;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ACharacter>> Characters;
+
+	// Ölçülecek modlar (-FootStepModes=)
+	TArray<EFootStepMode> Modes;
+	TArray<FFootStepBenchmarkResult> Results;
+
+	int32 CurrentModeIndex = INDEX_NONE;
+	double ModeStartTime = 0.0;
+	// NotifyUObjectCreated yükleme thread'lerinden de okur
+	std::atomic<bool> bMeasuring{ false };
+
+	// Ölçüm başındaki sayaçlar
+	FFootStepCounters StartCounters;
+
+	// Ölçüm sırasında biriken değerler
+	double GameThreadMsSum = 0.0;
+	double GameThreadMsMax = 0.0;
+	int32 MeasuredFrames = 0;
+
+	// Nesneler asenkron yükleme thread'lerinde de oluşturulabilir
+	std::atomic<int64> UObjectsCreated{ 0 };
+};
@@ -0,0 +1,158 @@
+﻿// Kalabalık sahnelerde ayak sesi efektlerini birleştiren ve bütçeleyen dünya alt sistemi.
+/**
+@ Thyke
+*/
+
+
+#include "FootStepCrowdSubsystem.h"
+#include "FootStepEffectPool.h"
+#include "FootStepNotify.h"
+#include "NiagaraComponent.h"
+#include "GameFramework/PlayerController.h"
+#include <Kismet/GameplayStatics.h>
+#include "NiagaraFunctionLibrary.h"
+
+namespace FootStepCrowd
+{
+    // Hücre koordinatları ve yüzey tipi tek bir anahtarda toplanır (eksen başına 21 bit)
+    static uint64 MakeCellKey(const FVector& Location, float CellSize, EPhysicalSurface SurfaceType)
+    {
+        const uint64 X = static_cast<uint64>(FMath::FloorToInt64(Location.X / CellSize)) & 0x1FFFFF;
+        const uint64 Y = static_cast<uint64>(FMath::FloorToInt64(Location.Y / CellSize)) & 0x1FFFFF;
+        const uint64 Z = static_cast<uint64>(FMath::FloorToInt64(Location.Z / CellSize)) & 0x3FFF;
+        return (X << 43) | (Y << 22) | (Z << 8) | static_cast<uint64>(SurfaceType);
+    }
+}
+
+bool UFootStepCrowdSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    // Dinleyici yokken tüm olaylar yakın sayılırdı, sunucuda birleştirme ve bütçe anlamsızdır
+    return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+TStatId UFootStepCrowdSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UFootStepCrowdSubsystem, STATGROUP_Tickables);
+}
+
+void UFootStepCrowdSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (PendingEvents.Num() == 0)
+    {
+        return;
+    }
+
+    // Mesafeler en yakın yerel oyuncu görüşüne göre ölçülür
+    UWorld* World = GetWorld();
+    TArray<FVector, TInlineAllocator<4>> ListenerLocations;
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (PlayerController && PlayerController->IsLocalController())
+        {
+            FVector ViewLocation;
+            FRotator ViewRotation;
+            PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+            ListenerLocations.Add(ViewLocation);
+        }
+    }
+
+    const float CullDistanceSq = FMath::Square(CullDistance);
+    const float AudioOnlyDistanceSq = FMath::Square(AudioOnlyDistance);
+    const float CellSize = FMath::Max(MergeCellSize, 1.0f);
+
+    MergedEvents.Reset();
+    MergedIndexByKey.Reset();
+    for (const FFootStepEvent& Event : PendingEvents)
+    {
+        // Dinleyici yoksa (sunucu, benchmark) tüm olaylar yakın sayılır
+        float DistanceSq = 0.0f;
+        if (ListenerLocations.Num() > 0)
+        {
+            DistanceSq = UE_MAX_FLT;
+            for (const FVector& ListenerLocation : ListenerLocations)
+            {
+                DistanceSq = FMath::Min(DistanceSq, static_cast<float>(FVector::DistSquared(ListenerLocation, Event.Location)));
+            }
+        }
+        if (DistanceSq > CullDistanceSq)
+        {
+            ++Stats.Culled;
+            continue;
+        }
+
+        const FMergeKey Key{ FootStepCrowd::MakeCellKey(Event.Location, CellSize, Event.SurfaceType), Event.SoundCue, Event.NiagaraSystem, Event.bUseEffectPool };
+        if (const int32* MergedIndex = MergedIndexByKey.Find(Key))
+        {
+            FMergedEvent& Merged = MergedEvents[*MergedIndex];
+            Merged.LocationSum += Event.Location;
+            Merged.DistanceSq = FMath::Min(Merged.DistanceSq, DistanceSq);
+            ++Merged.Count;
+            ++Stats.Merged;
+            continue;
+        }
+
+        MergedIndexByKey.Add(Key, MergedEvents.Num());
+        MergedEvents.Add(FMergedEvent{ Event, Event.Location, DistanceSq, 1 });
+    }
+    PendingEvents.Reset();
+
+    // Bütçe aşılırsa dinleyiciye en yakın olaylar oynatılır
+    if (MergedEvents.Num() > MaxEffectsPerFrame)
+    {
+        MergedEvents.Sort([](const FMergedEvent& A, const FMergedEvent& B) { return A.DistanceSq < B.DistanceSq; });
+        Stats.OverBudget += MergedEvents.Num() - MaxEffectsPerFrame;
+        MergedEvents.SetNum(FMath::Max(MaxEffectsPerFrame, 0), EAllowShrinking::No);
+    }
+
+    for (const FMergedEvent& Merged : MergedEvents)
+    {
+        PlayMergedEvent(Merged, Merged.DistanceSq > AudioOnlyDistanceSq);
+    }
+    Stats.Played += MergedEvents.Num();
+}
+
+void UFootStepCrowdSubsystem::PlayMergedEvent(const FMergedEvent& Merged, bool bAudioOnly)
+{
+    UWorld* World = GetWorld();
+    const FVector Location = Merged.LocationSum / Merged.Count;
+    const float Volume = FMath::Min(1.0f + (Merged.Count - 1) * VolumePerMergedEvent, MaxMergedVolume);
+
+    UFootStepEffectPool* EffectPool = Merged.Event.bUseEffectPool ? World->GetSubsystem<UFootStepEffectPool>() : nullptr;
+    if (Merged.Event.SoundCue)
+    {
+        if (EffectPool)
+        {
+            EffectPool->PlaySound(World, Merged.Event.SoundCue, Merged.Event.SurfaceType, Location, Volume);
+        }
+        else
+        {
+            ++FFootStepCounters::Get().SoundsPlayed;
+            UGameplayStatics::PlaySoundAtLocation(World, Merged.Event.SoundCue, Location, Volume);
+        }
+    }
+
+    if (bAudioOnly || !Merged.Event.NiagaraSystem)
+    {
+        return;
+    }
+
+    UNiagaraComponent* NiagaraComponent = nullptr;
+    if (EffectPool)
+    {
+        NiagaraComponent = EffectPool->SpawnNiagara(Merged.Event.NiagaraSystem, Location);
+    }
+    else
+    {
+        FFootStepCounters& Counters = FFootStepCounters::Get();
+        ++Counters.NiagaraActivations;
+        ++Counters.NiagaraComponentsCreated;
+        NiagaraComponent = UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, Merged.Event.NiagaraSystem, Location);
+    }
+    if (NiagaraComponent && !MergedCountParameter.IsNone())
+    {
+        NiagaraComponent->SetVariableFloat(MergedCountParameter, static_cast<float>(Merged.Count));
+    }
+}
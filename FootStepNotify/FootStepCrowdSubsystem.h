@@ -0,0 +1,143 @@
+﻿// Kalabalık sahnelerde ayak sesi efektlerini birleştiren ve bütçeleyen dünya alt sistemi.
+/**
+@ Thyke
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "FootStepCrowdSubsystem.generated.h"
+
+class USoundBase;
+class UNiagaraSystem;
+
+// Bir notify'ın bu frame oynatmak istediği ayak sesi
+struct FFootStepEvent
+{
+	FVector Location = FVector::ZeroVector;
+	USoundBase* SoundCue = nullptr;
+	UNiagaraSystem* NiagaraSystem = nullptr;
+	EPhysicalSurface SurfaceType = SurfaceType_Default;
+
+	// False ise olay efekt havuzu yerine doğrudan oynatılır (notify'ın bUseEffectPool ayarı)
+	bool bUseEffectPool = true;
+};
+
+// Kalabalık yöneticisinin sayaçları, her frame birikir
+struct FFootStepCrowdStats
+{
+	int64 Submitted = 0;
+
+	// Başka bir olayla birleştirilen olaylar
+	int64 Merged = 0;
+
+	// Dinleyiciye çok uzak olduğu için atılan olaylar
+	int64 Culled = 0;
+
+	// Frame bütçesi dolduğu için atılan olaylar
+	int64 OverBudget = 0;
+
+	int64 Played = 0;
+};
+
+// FootStepCrowdSubsystem - Tüm FootStepNotify'ların olaylarını toplayıp frame sonunda birlikte oynatır.
+// Aynı hücreye düşen, aynı yüzeyde aynı sesi ve Niagara sistemini oynatan olaylar tek, daha yüksek sesli ve daha yoğun bir efekte birleştirilir.
+// Dinleyiciye uzaklığa göre: yakında tam efekt, AudioOnlyDistance ötesinde yalnızca ses, CullDistance ötesinde hiçbir şey.
+// Frame başına en fazla MaxEffectsPerFrame efekt oynatılır, dinleyiciye en yakın olanlar önceliklidir.
+// Dinleyicisi olmayan dedicated server'larda oluşturulmaz, notify'lar o zaman kendi yollarıyla oynatır.
+UCLASS(Config = Game)
+class ETERNITY_API UFootStepCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// USubsystem Interface
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	// FTickableGameObject Interface
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Olayı bu frame'in kuyruğuna ekler
+	FORCEINLINE void Submit(const FFootStepEvent& Event)
+	{
+		PendingEvents.Add(Event);
+		++Stats.Submitted;
+	}
+
+	FORCEINLINE const FFootStepCrowdStats& GetStats() const { return Stats; }
+
+	// Birleştirme hücresinin boyutu (cm), aynı hücredeki aynı efektli olaylar birleşir
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Crowd")
+	float MergeCellSize = 150.0f;
+
+	// Frame başına oynatılacak en fazla efekt
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Crowd")
+	int32 MaxEffectsPerFrame = 32;
+
+	// Bu mesafenin ötesinde yalnızca ses çalınır (cm)
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Crowd")
+	float AudioOnlyDistance = 2000.0f;
+
+	// Bu mesafenin ötesinde hiçbir şey oynatılmaz (cm)
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Crowd")
+	float CullDistance = 5000.0f;
+
+	// Birleşen her ek olayın ses seviyesine eklediği pay
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Crowd")
+	float VolumePerMergedEvent = 0.1f;
+
+	// Birleşmiş bir olayın en yüksek ses çarpanı
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Crowd")
+	float MaxMergedVolume = 2.0f;
+
+	// Birleşen olay sayısının yazıldığı Niagara kullanıcı parametresi, efekt yoğunluğu için
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Crowd")
+	FName MergedCountParameter = TEXT("User.StepCount");
+
+private:
+	// Birleştirme anahtarı: farklı ses ya da Niagara sistemleri aynı hücrede bile birleşmez
+	struct FMergeKey
+	{
+		uint64 CellKey = 0;
+		USoundBase* SoundCue = nullptr;
+		UNiagaraSystem* NiagaraSystem = nullptr;
+		bool bUseEffectPool = true;
+
+		bool operator==(const FMergeKey& Other) const
+		{
+			return CellKey == Other.CellKey && SoundCue == Other.SoundCue && NiagaraSystem == Other.NiagaraSystem
+				&& bUseEffectPool == Other.bUseEffectPool;
+		}
+
+		friend uint32 GetTypeHash(const FMergeKey& Key)
+		{
+			uint32 Hash = HashCombine(GetTypeHash(Key.CellKey), GetTypeHash(Key.SoundCue));
+			Hash = HashCombine(Hash, GetTypeHash(Key.NiagaraSystem));
+			return HashCombine(Hash, GetTypeHash(Key.bUseEffectPool));
+		}
+	};
+
+	// Birleştirilmiş olay
+	struct FMergedEvent
+	{
+		FFootStepEvent Event;
+		FVector LocationSum;
+		float DistanceSq;
+		int32 Count;
+	};
+
+	// Oynatır, olay izin veriyorsa ve efekt havuzu varsa onu kullanır
+	void PlayMergedEvent(const FMergedEvent& Merged, bool bAudioOnly);
+
+	// Bu frame gönderilen olaylar
+	TArray<FFootStepEvent> PendingEvents;
+
+	// Frame'ler arasında yeniden kullanılan çalışma dizileri
+	TArray<FMergedEvent> MergedEvents;
+	TMap<FMergeKey, int32> MergedIndexByKey;
+
+	FFootStepCrowdStats Stats;
+};
@@ -0,0 +1,158 @@
+﻿// Ayak sesi efektleri için Niagara ve ses havuzu.
+/**
+@ Thyke
+*/
+
+
+#include "FootStepEffectPool.h"
+#include "FootStepNotify.h"
+#include "FootStepSurfaceData.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Sound/SoundConcurrency.h"
+#include <Kismet/GameplayStatics.h>
+
+void UFootStepEffectPool::Deinitialize()
+{
+    for (TPair<TObjectPtr<UNiagaraSystem>, FFootStepNiagaraPool>& Pair : NiagaraPools)
+    {
+        for (UNiagaraComponent* Component : Pair.Value.Components)
+        {
+            if (Component)
+            {
+                Component->DestroyComponent();
+            }
+        }
+    }
+    NiagaraPools.Empty();
+    Super::Deinitialize();
+}
+
+void UFootStepEffectPool::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Havuzlar ilk adımda değil, yükleme sırasında oluşturulur
+    for (const TSoftObjectPtr<UFootStepSurfaceData>& SurfaceData : PrewarmSurfaceData)
+    {
+        Prewarm(SurfaceData.LoadSynchronous());
+    }
+}
+
+void UFootStepEffectPool::Prewarm(const UFootStepSurfaceData* SurfaceData)
+{
+    if (!SurfaceData)
+    {
+        return;
+    }
+
+    Prewarm(SurfaceData->DefaultSurface.NiagaraSystem);
+    GetSurfaceConcurrency(SurfaceType_Default);
+    for (const FSurfaceData& Surface : SurfaceData->Surfaces)
+    {
+        Prewarm(Surface.NiagaraSystem);
+        GetSurfaceConcurrency(Surface.SurfaceType);
+    }
+}
+
+void UFootStepEffectPool::Prewarm(UNiagaraSystem* NiagaraSystem)
+{
+    if (NiagaraSystem && !NiagaraPools.Contains(NiagaraSystem))
+    {
+        FindOrCreatePool(NiagaraSystem);
+    }
+}
+
+FFootStepNiagaraPool& UFootStepEffectPool::FindOrCreatePool(UNiagaraSystem* NiagaraSystem)
+{
+    if (FFootStepNiagaraPool* Pool = NiagaraPools.Find(NiagaraSystem))
+    {
+        return *Pool;
+    }
+
+    UWorld* World = GetWorld();
+    FFootStepNiagaraPool& Pool = NiagaraPools.Add(NiagaraSystem);
+    Pool.Components.Reserve(PoolSizePerSystem);
+    for (int32 Index = 0; Index < FMath::Max(PoolSizePerSystem, 1); ++Index)
+    {
+        // Bileşenler sahipsiz olarak dünyaya kaydedilir ve biz bırakana kadar yaşar
+        UNiagaraComponent* Component = NewObject<UNiagaraComponent>(World);
+        Component->SetAsset(NiagaraSystem);
+        Component->SetAutoActivate(false);
+        Component->SetAutoDestroy(false);
+        Component->RegisterComponentWithWorld(World);
+        Pool.Components.Add(Component);
+        ++FFootStepCounters::Get().NiagaraComponentsCreated;
+    }
+    return Pool;
+}
+
+UNiagaraComponent* UFootStepEffectPool::SpawnNiagara(UNiagaraSystem* NiagaraSystem, const FVector& Location)
+{
+    if (!NiagaraSystem)
+    {
+        return nullptr;
+    }
+
+    const bool bPoolExisted = NiagaraPools.Contains(NiagaraSystem);
+    FFootStepNiagaraPool& Pool = FindOrCreatePool(NiagaraSystem);
+
+    UNiagaraComponent* Component = Pool.Components[Pool.NextIndex];
+    Pool.NextIndex = (Pool.NextIndex + 1) % Pool.Components.Num();
+
+    // Sıradaki bileşen hâlâ oynuyorsa havuz küçük kalmıştır, en eski efekt baştan başlatılır
+    if (!bPoolExisted)
+    {
+        ++Stats.Misses;
+    }
+    else if (Component->IsActive())
+    {
+        ++Stats.Overflows;
+    }
+    else
+    {
+        ++Stats.Hits;
+    }
+
+    ++FFootStepCounters::Get().NiagaraActivations;
+    Component->SetWorldLocation(Location);
+    Component->Activate(true);
+    return Component;
+}
+
+USoundConcurrency* UFootStepEffectPool::GetSurfaceConcurrency(EPhysicalSurface SurfaceType)
+{
+    TObjectPtr<USoundConcurrency>& Concurrency = SurfaceConcurrency[SurfaceType];
+    if (!Concurrency)
+    {
+        Concurrency = NewObject<USoundConcurrency>(this);
+        Concurrency->Concurrency.MaxCount = FMath::Max(MaxConcurrentSoundsPerSurface, 1);
+        Concurrency->Concurrency.ResolutionRule = EMaxConcurrentResolutionRule::StopOldest;
+    }
+    return Concurrency;
+}
+
+void UFootStepEffectPool::PlaySound(const UObject* WorldContextObject, USoundBase* Sound, EPhysicalSurface SurfaceType, const FVector& Location, float VolumeMultiplier)
+{
+    if (!Sound)
+    {
+        return;
+    }
+
+    ++Stats.SoundsPlayed;
+    ++FFootStepCounters::Get().SoundsPlayed;
+    UGameplayStatics::PlaySoundAtLocation(WorldContextObject, Sound, Location, FRotator::ZeroRotator, VolumeMultiplier, 1.0f, 0.0f, nullptr, GetSurfaceConcurrency(SurfaceType));
+}
+
+static FAutoConsoleCommandWithWorld FootStepPoolStatsCommand(
+    TEXT("FootStep.Pool.Stats"),
+    TEXT("Ayak sesi efekt havuzunun sayaçlarını yazdırır."),
+    FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+    {
+        if (const UFootStepEffectPool* Pool = World ? World->GetSubsystem<UFootStepEffectPool>() : nullptr)
+        {
+            const FFootStepEffectPoolStats& Stats = Pool->GetStats();
+            UE_LOG(LogTemp, Display, TEXT("FootStep pool: %lld hits, %lld misses, %lld overflows, %lld sounds"),
+                Stats.Hits, Stats.Misses, Stats.Overflows, Stats.SoundsPlayed);
+        }
+    }));
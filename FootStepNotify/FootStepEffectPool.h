@@ -0,0 +1,99 @@
+﻿// Ayak sesi efektleri için Niagara ve ses havuzu.
+/**
+@ Thyke
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "FootStepEffectPool.generated.h"
+
+class UNiagaraSystem;
+class UNiagaraComponent;
+class USoundBase;
+class USoundConcurrency;
+class UFootStepSurfaceData;
+
+// Bir Niagara sisteminin önceden oluşturulmuş bileşenleri
+USTRUCT()
+struct FFootStepNiagaraPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UNiagaraComponent>> Components;
+
+	// Sıradaki kullanılacak bileşen, havuz döngüsel kullanılır
+	int32 NextIndex = 0;
+};
+
+// Havuz sayaçları
+struct FFootStepEffectPoolStats
+{
+	// Boşta bir bileşen yeniden kullanıldı, meşgul bileşenler Overflows'a sayılır
+	int64 Hits = 0;
+
+	// Sistem için havuz yoktu, havuz oluşturuldu
+	int64 Misses = 0;
+
+	// Tüm bileşenler meşguldü, en eskisi yeniden başlatıldı
+	int64 Overflows = 0;
+
+	int64 SoundsPlayed = 0;
+};
+
+// FootStepEffectPool - Ayak sesi efektlerini her adımda yeni bileşen oluşturmadan oynatır.
+// Her Niagara sistemi için ayarlanabilir sayıda bileşen önceden oluşturulur ve sırayla yeniden kullanılır.
+// Sesler yüzey tipine göre ortak bir concurrency ayarı ile sınırlandırılır, sınır aşılınca en eski ses durur.
+UCLASS(Config = Game)
+class ETERNITY_API UFootStepEffectPool : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// UWorldSubsystem Interface
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	// Bir sistem için havuzu önceden oluşturur, ilk adımdaki oluşturma maliyetini yüklemeye taşımak için kullanılır
+	void Prewarm(UNiagaraSystem* NiagaraSystem);
+
+	// Bir yüzey verisindeki tüm Niagara sistemlerinin havuzlarını ve yüzeylerin ses concurrency ayarlarını önceden oluşturur
+	void Prewarm(const UFootStepSurfaceData* SurfaceData);
+
+	// Havuzdan bir bileşen alıp efekti konumda başlatır
+	UNiagaraComponent* SpawnNiagara(UNiagaraSystem* NiagaraSystem, const FVector& Location);
+
+	// Sesi yüzeyin concurrency sınırı ile konumda çalar
+	void PlaySound(const UObject* WorldContextObject, USoundBase* Sound, EPhysicalSurface SurfaceType, const FVector& Location, float VolumeMultiplier = 1.0f);
+
+	FORCEINLINE const FFootStepEffectPoolStats& GetStats() const { return Stats; }
+
+	// Her Niagara sistemi için oluşturulan bileşen sayısı
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Pool")
+	int32 PoolSizePerSystem = 16;
+
+	// Dünya başladığında havuzları önceden oluşturulan yüzey verileri, notify'ların kullandığı asset'ler buraya eklenmelidir
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Pool")
+	TArray<TSoftObjectPtr<UFootStepSurfaceData>> PrewarmSurfaceData;
+
+	// Aynı yüzey tipinde aynı anda çalabilecek ayak sesi sayısı
+	UPROPERTY(Config, EditAnywhere, Category = "Footstep Pool")
+	int32 MaxConcurrentSoundsPerSurface = 4;
+
+private:
+	FFootStepNiagaraPool& FindOrCreatePool(UNiagaraSystem* NiagaraSystem);
+
+	USoundConcurrency* GetSurfaceConcurrency(EPhysicalSurface SurfaceType);
+
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UNiagaraSystem>, FFootStepNiagaraPool> NiagaraPools;
+
+	// Yüzey tipi başına concurrency ayarı, ilk seste oluşturulur
+	UPROPERTY(Transient)
+	TObjectPtr<USoundConcurrency> SurfaceConcurrency[SurfaceType_Max];
+
+	FFootStepEffectPoolStats Stats;
+};
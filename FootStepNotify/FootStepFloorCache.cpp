@@ -0,0 +1,79 @@
+﻿// Karakterlerin yürüdüğü zeminin yüzey tipini ayak başına saklayan önbellek.
+/**
+@ Thyke
+*/
+
+
+#include "FootStepFloorCache.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "PhysicsEngine/BodySetup.h"
+
+bool UFootStepFloorCache::HasUniformSurface(const UPrimitiveComponent* FloorComponent)
+{
+    // Landscape çarpışmasının body setup'ı yoktur, katman başına fiziksel materyal heightfield'ın kendisindedir
+    const UBodySetup* BodySetup = const_cast<UPrimitiveComponent*>(FloorComponent)->GetBodySetup();
+    if (!BodySetup)
+    {
+        return false;
+    }
+
+    // Complex collision materyal başına fiziksel materyal döndürür, basit collision tek materyal kullanır
+    return BodySetup->GetCollisionTraceFlag() != CTF_UseComplexAsSimple;
+}
+
+bool UFootStepFloorCache::ResolveFloorSurface(const UCharacterMovementComponent* Movement, FName FootSocketName, const FVector& FootLocation,
+    FVector& OutLocation, EPhysicalSurface& OutSurfaceType, bool& bOutPhysMaterialFound)
+{
+    if (!Movement || !Movement->IsMovingOnGround())
+    {
+        return false;
+    }
+
+    const FFindFloorResult& Floor = Movement->CurrentFloor;
+    const UPrimitiveComponent* FloorComponent = Floor.HitResult.Component.Get();
+    if (!Floor.IsWalkableFloor() || !FloorComponent)
+    {
+        return false;
+    }
+
+    if (FloorByFoot.Num() >= PruneThreshold)
+    {
+        PruneStaleEntries();
+    }
+
+    // Zemin bileşeni değişmediyse yüzey de değişmemiştir
+    FFootFloor& FootFloor = FloorByFoot.FindOrAdd({ Movement, FootSocketName });
+    if (FootFloor.FloorComponent.Get() != FloorComponent)
+    {
+        // Zemin taraması fiziksel materyal döndürmez, basit çarpışmanın materyali kullanılır (notify trace'i de basit çarpışma kullanır)
+        FootFloor.FloorComponent = FloorComponent;
+        FootFloor.bNeedsTrace = !HasUniformSurface(FloorComponent);
+        const UPhysicalMaterial* PhysMaterial = FootFloor.bNeedsTrace ? nullptr : FloorComponent->BodyInstance.GetSimplePhysicalMaterial();
+        FootFloor.bPhysMaterialFound = PhysMaterial != nullptr;
+        FootFloor.SurfaceType = PhysMaterial ? UPhysicalMaterial::DetermineSurfaceType(PhysMaterial) : SurfaceType_Default;
+    }
+
+    if (FootFloor.bNeedsTrace)
+    {
+        return false;
+    }
+
+    // Efekt ayağın altında, zeminin yüksekliğinde oynatılır
+    OutLocation = FVector(FootLocation.X, FootLocation.Y, Floor.HitResult.ImpactPoint.Z);
+    OutSurfaceType = FootFloor.SurfaceType;
+    bOutPhysMaterialFound = FootFloor.bPhysMaterialFound;
+    return true;
+}
+
+void UFootStepFloorCache::PruneStaleEntries()
+{
+    for (auto It = FloorByFoot.CreateIterator(); It; ++It)
+    {
+        if (!It->Key.Key.ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+    PruneThreshold = FMath::Max(256, FloorByFoot.Num() * 2);
+}
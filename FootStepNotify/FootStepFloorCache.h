@@ -0,0 +1,54 @@
+﻿// Karakterlerin yürüdüğü zeminin yüzey tipini ayak başına saklayan önbellek.
+/**
+@ Thyke
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "UObject/ObjectKey.h"
+#include "FootStepFloorCache.generated.h"
+
+class UCharacterMovementComponent;
+class UPrimitiveComponent;
+
+// FootStepFloorCache - CharacterMovement'ın her tick bulduğu zemin (CurrentFloor) ile ayak sesi yüzeyini trace'siz çözer.
+// Her karakter ve ayak için son zemin bileşeni ve yüzey tipi saklanır, yalnızca zemin bileşeni değişince yeniden hesaplanır.
+// Karakter yerde değilse (havada, düşüyor) çözüm başarısız olur ve notify line trace'e döner.
+// Yüzeyi bileşen içinde değişen zeminlerde de (landscape katmanları, complex collision'ın materyal başına fiziksel materyalleri)
+// tek bir yüzey saklanamaz, bu zeminlerde de notify line trace'e döner.
+UCLASS()
+class ETERNITY_API UFootStepFloorCache : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Karakterin zemininden yüzeyi ve ayağın zemindeki konumunu bulur
+	// Zeminin fiziksel materyali yoksa bPhysMaterialFound false olur
+	bool ResolveFloorSurface(const UCharacterMovementComponent* Movement, FName FootSocketName, const FVector& FootLocation,
+		FVector& OutLocation, EPhysicalSurface& OutSurfaceType, bool& bOutPhysMaterialFound);
+
+private:
+	struct FFootFloor
+	{
+		TWeakObjectPtr<const UPrimitiveComponent> FloorComponent;
+		EPhysicalSurface SurfaceType = SurfaceType_Default;
+		bool bPhysMaterialFound = false;
+
+		// True ise zeminin yüzeyi isabet noktasına bağlıdır, trace gerekir
+		bool bNeedsTrace = false;
+	};
+
+	// Zeminin tüm bileşen için tek bir fiziksel materyali olup olmadığı
+	static bool HasUniformSurface(const UPrimitiveComponent* FloorComponent);
+
+	// Yok olan karakterlerin girdilerini temizler
+	void PruneStaleEntries();
+
+	TMap<TPair<TObjectKey<UCharacterMovementComponent>, FName>, FFootFloor> FloorByFoot;
+
+	// Bir sonraki temizliğin yapılacağı girdi sayısı
+	int32 PruneThreshold = 256;
+};
@@ -0,0 +1,73 @@
+﻿// Ayak izlerini yüzey başına tek bir instanced mesh ile çizen halka tamponu.
+/**
+@ Thyke
+*/
+
+
+#include "FootStepFootprintSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+
+void UFootStepFootprintSubsystem::Deinitialize()
+{
+    for (TPair<FFootprintRingKey, FFootprintRing>& Pair : Rings)
+    {
+        if (Pair.Value.Component)
+        {
+            Pair.Value.Component->DestroyComponent();
+        }
+    }
+    Rings.Empty();
+    Super::Deinitialize();
+}
+
+FFootprintRing& UFootStepFootprintSubsystem::FindOrCreateRing(UStaticMesh* Mesh, UMaterialInterface* Material)
+{
+    FFootprintRingKey Key;
+    Key.Mesh = Mesh;
+    Key.Material = Material;
+    if (FFootprintRing* Ring = Rings.Find(Key))
+    {
+        return *Ring;
+    }
+
+    UWorld* World = GetWorld();
+    UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(World);
+    Component->SetStaticMesh(Mesh);
+    if (Material)
+    {
+        Component->SetMaterial(0, Material);
+    }
+    Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Component->SetCastShadow(false);
+    Component->SetMobility(EComponentMobility::Movable);
+    Component->NumCustomDataFloats = NumCustomData;
+    Component->RegisterComponentWithWorld(World);
+
+    // Tüm instance'lar baştan sıfır ölçekle eklenir, adımlar yalnızca mevcut instance'ları günceller
+    const int32 Capacity = FMath::Max(FootprintCapacity, 1);
+    TArray<FTransform> HiddenTransforms;
+    HiddenTransforms.Init(FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), Capacity);
+    Component->AddInstances(HiddenTransforms, false, true);
+
+    FFootprintRing& Ring = Rings.Add(Key);
+    Ring.Component = Component;
+    return Ring;
+}
+
+void UFootStepFootprintSubsystem::AddFootprint(UStaticMesh* Mesh, UMaterialInterface* Material, const FTransform& Transform, float Lifetime)
+{
+    if (!Mesh)
+    {
+        return;
+    }
+
+    FFootprintRing& Ring = FindOrCreateRing(Mesh, Material);
+    UInstancedStaticMeshComponent* Component = Ring.Component;
+    const int32 InstanceIndex = Ring.NextInstance;
+    Ring.NextInstance = (Ring.NextInstance + 1) % Component->GetInstanceCount();
+
+    Component->UpdateInstanceTransform(InstanceIndex, Transform, true, false, true);
+    Component->SetCustomDataValue(InstanceIndex, 0, static_cast<float>(GetWorld()->GetTimeSeconds()), false);
+    Component->SetCustomDataValue(InstanceIndex, 1, FMath::Max(Lifetime, UE_KINDA_SMALL_NUMBER), true);
+}
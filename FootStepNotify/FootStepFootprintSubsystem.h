@@ -0,0 +1,82 @@
+﻿// Ayak izlerini yüzey başına tek bir instanced mesh ile çizen halka tamponu.
+/**
+@ Thyke
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FootStepFootprintSubsystem.generated.h"
+
+class UStaticMesh;
+class UMaterialInterface;
+class UInstancedStaticMeshComponent;
+
+// Halkaların anahtarı: aynı mesh farklı materyallerle ayrı halkalara çizilir
+USTRUCT()
+struct FFootprintRingKey
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TObjectPtr<UStaticMesh> Mesh;
+
+	// Boşsa mesh'in kendi materyali kullanılır
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInterface> Material;
+
+	bool operator==(const FFootprintRingKey& Other) const
+	{
+		return Mesh == Other.Mesh && Material == Other.Material;
+	}
+
+	friend uint32 GetTypeHash(const FFootprintRingKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.Mesh), GetTypeHash(Key.Material));
+	}
+};
+
+// Bir ayak izi mesh ve materyal çiftinin sabit kapasiteli instance halkası
+USTRUCT()
+struct FFootprintRing
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInstancedStaticMeshComponent> Component;
+
+	// Bir sonraki yazılacak instance, dolunca en eski iz ezilir
+	int32 NextInstance = 0;
+};
+
+// FootStepFootprintSubsystem - Kar, çamur, kum gibi yüzeylerde ayak izi bırakır.
+// Her ayak izi mesh ve materyal çifti için bir instanced static mesh bileşeni oluşturulur ve kapasitesi kadar gizli instance ile doldurulur.
+// Her adım yalnızca sıradaki instance'ın transform'unu ve custom data'sını günceller: tahsis yok, yeni bileşen yok.
+// Solma materyalde yapılır: custom data 0 izin oluştuğu dünya zamanı, custom data 1 ömrüdür (saniye).
+// Materyal (Time - CustomData0) / CustomData1 ile opaklığı düşürmelidir.
+UCLASS(Config = Game)
+class ETERNITY_API UFootStepFootprintSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// UWorldSubsystem Interface
+	virtual void Deinitialize() override;
+
+	// Bir ayak izi bırakır
+	void AddFootprint(UStaticMesh* Mesh, UMaterialInterface* Material, const FTransform& Transform, float Lifetime);
+
+	// Mesh ve materyal çifti başına en fazla ayak izi, dolunca en eski iz yeniden kullanılır
+	UPROPERTY(Config, EditAnywhere, Category = "Footprints")
+	int32 FootprintCapacity = 512;
+
+	// Custom data kanallarının sayısı: oluşma zamanı ve ömür
+	static constexpr int32 NumCustomData = 2;
+
+private:
+	FFootprintRing& FindOrCreateRing(UStaticMesh* Mesh, UMaterialInterface* Material);
+
+	UPROPERTY(Transient)
+	TMap<FFootprintRingKey, FFootprintRing> Rings;
+};
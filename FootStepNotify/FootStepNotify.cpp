@@ -10,6 +10,29 @@
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
+#include "FootStepEffectPool.h"
+#include "FootStepCrowdSubsystem.h"
+#include "FootStepFloorCache.h"
+#include "FootStepFootprintSubsystem.h"
+#include "GameFramework/Character.h"
+
+namespace FootStep
+{
+    static int32 Mode = 0;
+    static FAutoConsoleVariableRef CVarMode(
+        TEXT("FootStep.Mode"),
+        Mode,
+        TEXT("Tüm ayak sesi notify'larının çalışma şekli. 0: notify ayarları, 1: senkron trace, 2: asenkron trace, 3: hareket zemini, 4: hareket zemini + kalabalık yöneticisi"));
+
+    // Ölü, sinematikteki vb. karakterlerin mesh'lerine UStatusGateComponent tarafından eklenir (FootstepGateTag ile aynı olmalı)
+    static const FName GatedTag(TEXT("FootStep.Gated"));
+}
+
+FFootStepCounters& FFootStepCounters::Get()
+{
+    static FFootStepCounters Counters;
+    return Counters;
+}
 
 UFootStepNotify::UFootStepNotify()
 {
@@ -21,63 +44,227 @@ void UFootStepNotify::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase
     {
         return;
     }
+    // Sahibin durumu ayak seslerini kapatmışsa trace ve efekt yapılmaz
+    if (MeshComp->ComponentHasTag(FootStep::GatedTag))
+    {
+        return;
+    }
+    ++FFootStepCounters::Get().Notifies;
     LineTraceFootstepSoundAndParticles(MeshComp);
 }
 
+void UFootStepNotify::GetEffectiveOptions(bool& bOutMovementFloor, bool& bOutAsyncTrace, bool& bOutEffectPool, bool& bOutCrowdManager) const
+{
+    const EFootStepMode ModeOverride = static_cast<EFootStepMode>(FootStep::Mode);
+    if (ModeOverride <= EFootStepMode::NotifySettings || ModeOverride >= EFootStepMode::Count)
+    {
+        bOutMovementFloor = bUseMovementFloor;
+        bOutAsyncTrace = bUseAsyncTrace;
+        bOutEffectPool = bUseEffectPool;
+        bOutCrowdManager = bUseCrowdManager;
+        return;
+    }
+
+    bOutMovementFloor = ModeOverride == EFootStepMode::MovementFloor || ModeOverride == EFootStepMode::MovementFloorCrowd;
+    bOutAsyncTrace = ModeOverride == EFootStepMode::AsyncTrace;
+    bOutEffectPool = ModeOverride != EFootStepMode::SyncTrace;
+    bOutCrowdManager = ModeOverride == EFootStepMode::MovementFloorCrowd;
+}
+
 void UFootStepNotify::PlaySoundAndSpawnParticles(USkeletalMeshComponent* MeshComp, USoundBase* SoundCue, UNiagaraSystem* NiagaraSystem, FVector Location)
 {
     if (SoundCue)
     {
+        ++FFootStepCounters::Get().SoundsPlayed;
         UGameplayStatics::PlaySoundAtLocation(MeshComp, SoundCue, Location);
     }
     if (NiagaraSystem)
     {
+        FFootStepCounters& Counters = FFootStepCounters::Get();
+        ++Counters.NiagaraActivations;
+        ++Counters.NiagaraComponentsCreated;
         UNiagaraFunctionLibrary::SpawnSystemAtLocation(MeshComp->GetWorld(), NiagaraSystem, Location);
     }
 }
 
-void UFootStepNotify::LineTraceFootstepSoundAndParticles(USkeletalMeshComponent* MeshComp)
+bool UFootStepNotify::BuildFootstepTrace(USkeletalMeshComponent* MeshComp, FVector& OutStart, FVector& OutEnd, FCollisionQueryParams& OutQueryParams) const
 {
     // Mesh component'in sahibi olan karakter alınır
     AActor* Owner = MeshComp->GetOwner();
     // Eğer sahibi yoksa, işlem sonlandırılır
     if (Owner == nullptr)
     {
-        return;
+        return false;
     }
     // Skeletal mesh'in socket pozisyonu alınır(foot_l_socket gibi)
-    FVector SocketLocation = MeshComp->GetSocketLocation(FootSocketName);
+    OutStart = MeshComp->GetSocketLocation(FootSocketName);
 
     // Line trace için hedef pozisyonu ayarla (socket pozisyonunun 50 birim altında, bu değeri artırabiliriz.)
-    FVector TargetLocation = SocketLocation - FVector(0, 0, 50.0f);
+    OutEnd = OutStart - FVector(0, 0, 50.0f);
 
     // Line trace için çarpışma sorgusu parametreleri ayarla
-    FCollisionQueryParams QueryParams;
-    QueryParams.AddIgnoredActor(Owner);
-    QueryParams.bTraceComplex = false;
-    QueryParams.bReturnPhysicalMaterial = true;
+    OutQueryParams.AddIgnoredActor(Owner);
+    OutQueryParams.bTraceComplex = false;
+    OutQueryParams.bReturnPhysicalMaterial = true;
+    return true;
+}
+
+void UFootStepNotify::PlayFootstepEffects(USkeletalMeshComponent* MeshComp, const FSurfaceData& Surface, EPhysicalSurface SurfaceType, const FVector& Location)
+{
+    // Ayak izleri birleştirilmez, her ayak kendi izini bırakır
+    if (bSpawnFootprints && Surface.FootprintMesh)
+    {
+        if (UFootStepFootprintSubsystem* Footprints = MeshComp->GetWorld()->GetSubsystem<UFootStepFootprintSubsystem>())
+        {
+            // İz karakterin baktığı yöne döner, mesh'in kendi dönüşü (genelde -90) hesaba katılmaz
+            const AActor* Owner = MeshComp->GetOwner();
+            const FRotator Rotation(0.0f, Owner ? Owner->GetActorRotation().Yaw : MeshComp->GetComponentRotation().Yaw, 0.0f);
+            Footprints->AddFootprint(Surface.FootprintMesh, Surface.FootprintMaterial, FTransform(Rotation, Location, Surface.FootprintScale), Surface.FootprintLifetime);
+        }
+    }
+
+    bool bMovementFloor, bAsyncTrace, bEffectPool, bCrowdManager;
+    GetEffectiveOptions(bMovementFloor, bAsyncTrace, bEffectPool, bCrowdManager);
+
+    if (UFootStepCrowdSubsystem* CrowdSubsystem = bCrowdManager ? MeshComp->GetWorld()->GetSubsystem<UFootStepCrowdSubsystem>() : nullptr)
+    {
+        CrowdSubsystem->Submit(FFootStepEvent{ Location, Surface.SoundCue, Surface.NiagaraSystem, SurfaceType, bEffectPool });
+        return;
+    }
+
+    UFootStepEffectPool* EffectPool = bEffectPool ? MeshComp->GetWorld()->GetSubsystem<UFootStepEffectPool>() : nullptr;
+    if (!EffectPool)
+    {
+        PlaySoundAndSpawnParticles(MeshComp, Surface.SoundCue, Surface.NiagaraSystem, Location);
+        return;
+    }
+    EffectPool->PlaySound(MeshComp, Surface.SoundCue, SurfaceType, Location);
+    EffectPool->SpawnNiagara(Surface.NiagaraSystem, Location);
+}
+
+void UFootStepNotify::LineTraceFootstepSoundAndParticles(USkeletalMeshComponent* MeshComp)
+{
+    bool bMovementFloor, bAsyncTrace, bEffectPool, bCrowdManager;
+    GetEffectiveOptions(bMovementFloor, bAsyncTrace, bEffectPool, bCrowdManager);
+
+    // Karakter zaten zemini biliyorsa trace'e gerek yoktur
+    if (bMovementFloor && TryMovementFloorFootstep(MeshComp))
+    {
+        ++FFootStepCounters::Get().FloorResolves;
+        return;
+    }
+
+    if (bAsyncTrace)
+    {
+        AsyncLineTraceFootstep(MeshComp);
+        return;
+    }
+
+    FVector SocketLocation;
+    FVector TargetLocation;
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FootStepTrace));
+    if (!BuildFootstepTrace(MeshComp, SocketLocation, TargetLocation, QueryParams))
+    {
+        return;
+    }
 
     // Socket pozisyonundan hedef pozisyona line trace yap
     // Eğer çarpışma olursa, çarpışma bilgilerini HitResult değişkenine ata
+    ++FFootStepCounters::Get().SyncTraces;
     FHitResult HitResult;
-    bool bHit = GetWorld()->LineTraceSingleByChannel(HitResult, SocketLocation, TargetLocation, ECC_Visibility, QueryParams);
+    bool bHit = MeshComp->GetWorld()->LineTraceSingleByChannel(HitResult, SocketLocation, TargetLocation, ECC_Visibility, QueryParams);
     if (bHit)
     {
-        UPhysicalMaterial* PhysMaterial = HitResult.PhysMaterial.Get();
-        EPhysicalSurface SurfaceType = SurfaceType_Default;
-        if (PhysMaterial)
+        HandleFootstepHit(MeshComp, HitResult);
+    }
+}
+
+void UFootStepNotify::AsyncLineTraceFootstep(USkeletalMeshComponent* MeshComp)
+{
+    FVector SocketLocation;
+    FVector TargetLocation;
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FootStepAsyncTrace));
+    if (!BuildFootstepTrace(MeshComp, SocketLocation, TargetLocation, QueryParams))
+    {
+        return;
+    }
+
+    // Mesh sonuç gelene kadar yok olabilir, bu yüzden zayıf referans olarak taşınır
+    // Soket pozisyonu sorgunun kendisinde saklanır, efekt isabet noktasında oynatılır
+    ++FFootStepCounters::Get().AsyncTraces;
+    FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &UFootStepNotify::OnAsyncFootstepTraceDone, TWeakObjectPtr<USkeletalMeshComponent>(MeshComp));
+    MeshComp->GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, SocketLocation, TargetLocation, ECC_Visibility, QueryParams,
+        FCollisionResponseParams::DefaultResponseParam, &TraceDelegate);
+}
+
+void UFootStepNotify::OnAsyncFootstepTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, TWeakObjectPtr<USkeletalMeshComponent> WeakMeshComp)
+{
+    USkeletalMeshComponent* MeshComp = WeakMeshComp.Get();
+    if (!MeshComp || TraceDatum.OutHits.Num() == 0)
+    {
+        return;
+    }
+    HandleFootstepHit(MeshComp, TraceDatum.OutHits[0]);
+}
+
+const FSurfaceData* UFootStepNotify::FindSurfaceData(EPhysicalSurface SurfaceType) const
+{
+    if (SurfaceData)
+    {
+        return SurfaceData->FindSurface(SurfaceType);
+    }
+
+    // Loop through SurfaceData array to find a matching surface
+    for (const FSurfaceData& Surface : SurfaceDataTable)
+    {
+        if (Surface.SurfaceType == SurfaceType)
         {
-            SurfaceType = UPhysicalMaterial::DetermineSurfaceType(PhysMaterial);
-            // Loop through SurfaceData array to find a matching surface
-            for (const FSurfaceData& SurfaceData : SurfaceDataTable)
-            {
-                if (SurfaceData.SurfaceType == SurfaceType)
-                {
-                    // Play corresponding sound and spawn particles
-                    PlaySoundAndSpawnParticles(MeshComp, SurfaceData.SoundCue, SurfaceData.NiagaraSystem, HitResult.Location);
-                    break;
-                }
-            }
+            return &Surface;
         }
     }
+    return nullptr;
+}
+
+void UFootStepNotify::HandleFootstepHit(USkeletalMeshComponent* MeshComp, const FHitResult& HitResult)
+{
+    UPhysicalMaterial* PhysMaterial = HitResult.PhysMaterial.Get();
+    const EPhysicalSurface SurfaceType = PhysMaterial ? UPhysicalMaterial::DetermineSurfaceType(PhysMaterial) : SurfaceType_Default;
+    HandleFootstepSurface(MeshComp, PhysMaterial != nullptr, SurfaceType, HitResult.Location);
+}
+
+void UFootStepNotify::HandleFootstepSurface(USkeletalMeshComponent* MeshComp, bool bPhysMaterialFound, EPhysicalSurface SurfaceType, const FVector& Location)
+{
+    // Fiziksel materyal yoksa yalnızca paylaşılan tablonun varsayılan verisi kullanılır
+    if (!bPhysMaterialFound && !SurfaceData)
+    {
+        return;
+    }
+
+    if (const FSurfaceData* Surface = FindSurfaceData(SurfaceType))
+    {
+        // Play corresponding sound and spawn particles
+        PlayFootstepEffects(MeshComp, *Surface, SurfaceType, Location);
+    }
+}
+
+bool UFootStepNotify::TryMovementFloorFootstep(USkeletalMeshComponent* MeshComp)
+{
+    const ACharacter* Character = Cast<ACharacter>(MeshComp->GetOwner());
+    UFootStepFloorCache* FloorCache = Character ? MeshComp->GetWorld()->GetSubsystem<UFootStepFloorCache>() : nullptr;
+    if (!FloorCache)
+    {
+        return false;
+    }
+
+    FVector Location;
+    EPhysicalSurface SurfaceType = SurfaceType_Default;
+    bool bPhysMaterialFound = false;
+    if (!FloorCache->ResolveFloorSurface(Character->GetCharacterMovement(), FootSocketName, MeshComp->GetSocketLocation(FootSocketName),
+        Location, SurfaceType, bPhysMaterialFound))
+    {
+        return false;
+    }
+
+    HandleFootstepSurface(MeshComp, bPhysMaterialFound, SurfaceType, Location);
+    return true;
 }
\ No newline at end of file
@@ -10,22 +10,40 @@
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 #include "EternityGameInstance.h"
+#include "WorldCollision.h"
+#include "FootStepSurfaceData.h"
 #include "FootStepNotify.generated.h"
 
 
-USTRUCT(BlueprintType)
-struct FSurfaceData
+// FootStep.Mode konsol değişkeninin değerleri, tüm notify'ların ayarlarını ölçüm için geçersiz kılar
+enum class EFootStepMode : int32
 {
-	GENERATED_BODY()
+	// Her notify kendi ayarlarını kullanır
+	NotifySettings = 0,
+	// Senkron trace, doğrudan oynatma (ilk sürümdeki davranış)
+	SyncTrace = 1,
+	// Asenkron trace, havuzdan oynatma
+	AsyncTrace = 2,
+	// Hareket bileşeninin zemini, havuzdan oynatma
+	MovementFloor = 3,
+	// Hareket bileşeninin zemini, kalabalık yöneticisi
+	MovementFloorCrowd = 4,
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data")
-	TEnumAsByte<EPhysicalSurface> SurfaceType;
+	Count
+};
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data")
-	USoundBase* SoundCue;
+// Ayak sesi sayaçları, benchmark ve profil için; yalnızca oyun thread'inde artar
+struct ETERNITY_API FFootStepCounters
+{
+	int64 Notifies = 0;
+	int64 SyncTraces = 0;
+	int64 AsyncTraces = 0;
+	int64 FloorResolves = 0;
+	int64 NiagaraActivations = 0;
+	int64 NiagaraComponentsCreated = 0;
+	int64 SoundsPlayed = 0;
 
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data")
-	UNiagaraSystem* NiagaraSystem;
+	static FFootStepCounters& Get();
 };
 
 UCLASS()
@@ -44,9 +62,62 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data")
 	TArray<FSurfaceData> SurfaceDataTable;
 
+	// Paylaşılan yüzey tablosu, atanmışsa SurfaceDataTable yerine kullanılır ve arama sabit zamanlıdır
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data")
+	TObjectPtr<UFootStepSurfaceData> SurfaceData;
+
+	// Yüzey tipine ait veriyi bulur, paylaşılan tablo yoksa SurfaceDataTable'da arar
+	const FSurfaceData* FindSurfaceData(EPhysicalSurface SurfaceType) const;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Settings")
 	FName FootSocketName;
 
+	// True ise yerde yürüyen karakterlerde yüzey CharacterMovement zemininden alınır ve trace yapılmaz
+	// Karakter olmayan mesh'lerde, havadaki frame'lerde ve yüzeyi noktadan noktaya değişen zeminlerde (landscape) line trace kullanılır
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Settings")
+	bool bUseMovementFloor = true;
+
+	// True ise olay FootStepCrowdSubsystem'e gönderilir, birleştirme, bütçe ve mesafe LOD'u ondan sonra uygulanır
+	// Kalabalık sahneler için isteğe bağlıdır, mevcut notify'ların davranışı değişmesin diye kapalı gelir
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Settings")
+	bool bUseCrowdManager = false;
+
+	// True ise yüzeyin ayak izi mesh'i varsa FootStepFootprintSubsystem ile iz bırakılır
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Settings")
+	bool bSpawnFootprints = true;
+
+	// True ise efektler dünyanın FootStepEffectPool havuzundan oynatılır, her adımda yeni bileşen oluşturulmaz
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Settings")
+	bool bUseEffectPool = true;
+
+	// True ise zemin sorgusu asenkron yapılır, sonuç bir sonraki frame'de gelir ve efektler o zaman oynatılır
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Footstep Settings")
+	bool bUseAsyncTrace = false;
+
 	UFUNCTION()
 	void LineTraceFootstepSoundAndParticles(USkeletalMeshComponent* MeshComp);
+
+	// Zemin sorgusunu asenkron trace kuyruğuna ekler, motor tüm asenkron trace'leri frame sonunda toplu çalıştırır
+	void AsyncLineTraceFootstep(USkeletalMeshComponent* MeshComp);
+
+	// Asenkron trace tamamlandığında çağrılır
+	void OnAsyncFootstepTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, TWeakObjectPtr<USkeletalMeshComponent> WeakMeshComp);
+
+	// Senkron ve asenkron yolların ortak isabet işleyicisi: yüzeyi bulur, sesi ve efekti oynatır
+	void HandleFootstepHit(USkeletalMeshComponent* MeshComp, const FHitResult& HitResult);
+
+	// Yüzeyin verisini bulup oynatır, fiziksel materyal yoksa yalnızca paylaşılan tablonun varsayılanı kullanılır
+	void HandleFootstepSurface(USkeletalMeshComponent* MeshComp, bool bPhysMaterialFound, EPhysicalSurface SurfaceType, const FVector& Location);
+
+	// Sahibi yerde yürüyen bir karakterse yüzeyi hareket bileşeninin zemininden çözer
+	bool TryMovementFloorFootstep(USkeletalMeshComponent* MeshComp);
+
+	// Yüzeyin sesini ve efektini havuzdan ya da doğrudan oynatır
+	void PlayFootstepEffects(USkeletalMeshComponent* MeshComp, const FSurfaceData& Surface, EPhysicalSurface SurfaceType, const FVector& Location);
+
+	// FootStep.Mode ayarlanmışsa onun, değilse notify'ın ayarlarını döndürür
+	void GetEffectiveOptions(bool& bOutMovementFloor, bool& bOutAsyncTrace, bool& bOutEffectPool, bool& bOutCrowdManager) const;
+
+	// Sorgu parametrelerini ve ayak soketinin başlangıç/bitiş noktalarını hazırlar
+	bool BuildFootstepTrace(USkeletalMeshComponent* MeshComp, FVector& OutStart, FVector& OutEnd, FCollisionQueryParams& OutQueryParams) const;
 };
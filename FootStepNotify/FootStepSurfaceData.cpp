@@ -0,0 +1,54 @@
+﻿// Ayak sesi yüzey verisi, tüm FootStepNotify örnekleri tarafından paylaşılan data asset.
+/**
+@ Thyke
+*/
+
+
+#include "FootStepSurfaceData.h"
+
+void UFootStepSurfaceData::PostInitProperties()
+{
+    Super::PostInitProperties();
+    BuildLookup();
+}
+
+void UFootStepSurfaceData::PostLoad()
+{
+    Super::PostLoad();
+    BuildLookup();
+}
+
+#if WITH_EDITOR
+void UFootStepSurfaceData::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    BuildLookup();
+}
+
+void UFootStepSurfaceData::PostEditUndo()
+{
+    Super::PostEditUndo();
+    BuildLookup();
+}
+#endif
+
+void UFootStepSurfaceData::BuildLookup()
+{
+    // Varsayılan veri boşsa, tablodaki SurfaceType_Default girdisi yedek olarak kullanılır
+    int16 FallbackIndex = INDEX_NONE;
+    if (!HasDefaultSurface())
+    {
+        FallbackIndex = static_cast<int16>(Surfaces.IndexOfByPredicate([](const FSurfaceData& Surface) { return Surface.SurfaceType == SurfaceType_Default; }));
+    }
+
+    for (int16& Entry : SurfaceLookup)
+    {
+        Entry = FallbackIndex;
+    }
+
+    // Aynı yüzey birden fazla kez tanımlanmışsa, eski davranıştaki gibi ilk girdi geçerlidir
+    for (int32 Index = FMath::Min(Surfaces.Num(), static_cast<int32>(MAX_int16)) - 1; Index >= 0; --Index)
+    {
+        SurfaceLookup[Surfaces[Index].SurfaceType] = static_cast<int16>(Index);
+    }
+}
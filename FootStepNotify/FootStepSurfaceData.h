@@ -0,0 +1,96 @@
+﻿// Ayak sesi yüzey verisi, tüm FootStepNotify örnekleri tarafından paylaşılan data asset.
+/**
+@ Thyke
+*/
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "NiagaraSystem.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "FootStepSurfaceData.generated.h"
+
+
+USTRUCT(BlueprintType)
+struct FSurfaceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data")
+	TEnumAsByte<EPhysicalSurface> SurfaceType;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data")
+	USoundBase* SoundCue;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data")
+	UNiagaraSystem* NiagaraSystem;
+
+	// İsteğe bağlı ayak izi, boşsa bu yüzeyde iz bırakılmaz
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data|Footprint")
+	UStaticMesh* FootprintMesh = nullptr;
+
+	// Ayak izi materyali, custom data 0 (oluşma zamanı) ve 1 (ömür) ile solmalıdır
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data|Footprint")
+	UMaterialInterface* FootprintMaterial = nullptr;
+
+	// Ayak izinin tamamen solduğu süre (saniye)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data|Footprint")
+	float FootprintLifetime = 20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface Data|Footprint")
+	FVector FootprintScale = FVector::OneVector;
+};
+
+// Yüzey tipinden efekte sabit zamanlı arama tablosu.
+// Yüklemede her EPhysicalSurface değeri için bir işaretçi hesaplanır, eşleşmeyen yüzeyler varsayılana düşer.
+// Arama tek bir dizi okumasıdır, aynı asset'i kullanan tüm notify'lar tabloyu paylaşır.
+UCLASS(BlueprintType)
+class ETERNITY_API UFootStepSurfaceData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
+#endif
+
+	// Yüzey tipine ait veriyi döndürür, tabloda yoksa varsayılan veriyi, o da boşsa nullptr döndürür
+	FORCEINLINE const FSurfaceData* FindSurface(EPhysicalSurface SurfaceType) const
+	{
+		const int32 Index = SurfaceLookup[SurfaceType];
+		if (Surfaces.IsValidIndex(Index))
+		{
+			return &Surfaces[Index];
+		}
+		return HasDefaultSurface() ? &DefaultSurface : nullptr;
+	}
+
+	// Yüzey tiplerine göre ses ve efektler
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface Data")
+	TArray<FSurfaceData> Surfaces;
+
+	// Fiziksel materyal olmadığında veya yüzey tabloda bulunmadığında kullanılır.
+	// Boş bırakılırsa SurfaceType_Default girdisi kullanılır.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface Data")
+	FSurfaceData DefaultSurface;
+
+private:
+	// Surfaces ve DefaultSurface'den arama tablosunu yeniden oluşturur
+	void BuildLookup();
+
+	// DefaultSurface'e ses, efekt veya iz atanmış mı
+	FORCEINLINE bool HasDefaultSurface() const
+	{
+		return DefaultSurface.SoundCue || DefaultSurface.NiagaraSystem || DefaultSurface.FootprintMesh;
+	}
+
+	// Her yüzey tipi için Surfaces içindeki indeks, -1 ise DefaultSurface kullanılır.
+	// Dizi yeniden boyutlandırılınca bozulmaması için pointer yerine indeks tutulur.
+	int16 SurfaceLookup[SurfaceType_Max];
+};
@@ -0,0 +1,495 @@
+// https://github.com/microsoft/proxy/blob/main/proxy.h
+
+#include "DispatchBenchmarkCommandlet.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "proxy.h"
+#include <atomic>
+#include <functional>
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(DispatchBenchmarkCommandlet)
+
+namespace DispatchBenchmark
+{
+	// Number of callable types on the megamorphic call site
+	static constexpr int32 NumOpTypes = 8;
+
+	// Allocation counts of the benchmark thread
+	struct FAllocationCounts
+	{
+		int64 Allocations = 0;
+		int64 Bytes = 0;
+
+		FAllocationCounts operator-(const FAllocationCounts& Other) const
+		{
+			return { Allocations - Other.Allocations, Bytes - Other.Bytes };
+		}
+	};
+
+	// Forwards everything to the previous GMalloc and counts the allocations made by one thread,
+	// so engine threads running in the background do not show up in the results
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		FCountingMalloc(FMalloc* InInner, uint32 InThreadId)
+			: Inner(InInner)
+			, ThreadId(InThreadId)
+		{
+		}
+
+		FAllocationCounts GetCounts() const
+		{
+			return { Allocations.load(std::memory_order_relaxed), Bytes.load(std::memory_order_relaxed) };
+		}
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			RecordAllocation(Count);
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+		{
+			RecordAllocation(Count);
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			RecordAllocation(Count);
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			RecordAllocation(Count);
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		void RecordAllocation(SIZE_T Size)
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId)
+			{
+				Allocations.fetch_add(1, std::memory_order_relaxed);
+				Bytes.fetch_add(static_cast<int64>(Size), std::memory_order_relaxed);
+			}
+		}
+
+		FMalloc* Inner;
+		uint32 ThreadId;
+		std::atomic<int64> Allocations{ 0 };
+		std::atomic<int64> Bytes{ 0 };
+	};
+
+	// Never destroyed, memory allocated through it may be freed after the run
+	static FCountingMalloc* CountingMalloc = nullptr;
+
+	static FAllocationCounts GetAllocationCounts()
+	{
+		return CountingMalloc ? CountingMalloc->GetCounts() : FAllocationCounts();
+	}
+
+	// Callable with the capture of a typical listener: one pointer and one value
+	template<int32 K>
+	struct TBenchOp
+	{
+		static constexpr int32 Index = K;
+
+		const void* Context = nullptr;
+		int32 Offset = K;
+
+		int32 operator()(int32 X) const { return X * (K + 2) + Offset; }
+	};
+
+	// Shared instances, TFunctionRef only references its callable
+	template<int32 K>
+	const TBenchOp<K>& GetOp()
+	{
+		static const TBenchOp<K> Op;
+		return Op;
+	}
+
+	// Virtual interface equivalent of TBenchOp
+	struct IBenchOp
+	{
+		virtual ~IBenchOp() = default;
+		virtual int32 Call(int32 X) const = 0;
+	};
+
+	template<int32 K>
+	struct TVirtualBenchOp final : IBenchOp
+	{
+		virtual int32 Call(int32 X) const override { return Op(X); }
+
+		TBenchOp<K> Op;
+	};
+
+	// declare facade: same signature, default inline layout (two pointers)
+	struct FBenchFacade : pro::facade_builder
+		::add_convention<pro::operator_dispatch<"()", false>, int32(int32)>
+		::build {};
+
+	DECLARE_DELEGATE_RetVal_OneParam(int32, FBenchDelegate, int32);
+
+	// Calls Visitor with the shared op of a type index
+	template<typename VisitorType>
+	void VisitOp(uint8 TypeIndex, VisitorType&& Visitor)
+	{
+		switch (TypeIndex)
+		{
+		case 0: Visitor(GetOp<0>()); break;
+		case 1: Visitor(GetOp<1>()); break;
+		case 2: Visitor(GetOp<2>()); break;
+		case 3: Visitor(GetOp<3>()); break;
+		case 4: Visitor(GetOp<4>()); break;
+		case 5: Visitor(GetOp<5>()); break;
+		case 6: Visitor(GetOp<6>()); break;
+		default: Visitor(GetOp<7>()); break;
+		}
+	}
+
+	struct FSettings
+	{
+		int32 Items = 1024;
+		int32 Passes = 200;
+		int32 Repeats = 5;
+	};
+
+	struct FResult
+	{
+		FString Name;
+		FString CallSite;
+		int32 InlineBytes = 0;
+		double NsPerCall = 0.0;
+		double ConstructNsPerItem = 0.0;
+		double BytesPerItem = 0.0;
+		double AllocationsPerItem = 0.0;
+		int64 CallAllocations = 0;
+	};
+
+	// Keeps the compiler from removing the calls
+	static volatile int64 Sink = 0;
+
+	// Measures one mechanism: Build fills the container from the type indices, Call runs one pass and returns a checksum.
+	// The best of Repeats runs is kept for the timings.
+	template<typename ElementType, typename BuildType, typename CallType>
+	FResult RunCase(const FSettings& Settings, const TCHAR* Name, const TCHAR* CallSite, TConstArrayView<uint8> TypeIndices, BuildType&& Build, CallType&& Call)
+	{
+		FResult Result;
+		Result.Name = Name;
+		Result.CallSite = CallSite;
+		Result.InlineBytes = sizeof(ElementType);
+
+		const int32 NumItems = TypeIndices.Num();
+
+		// Construction, the container itself is allocated beforehand
+		double BestBuildSeconds = UE_DOUBLE_BIG_NUMBER;
+		FAllocationCounts BuildCounts;
+		for (int32 Repeat = 0; Repeat < Settings.Repeats; ++Repeat)
+		{
+			TArray<ElementType> Items;
+			Items.Reserve(NumItems);
+
+			const FAllocationCounts Before = GetAllocationCounts();
+			const double Start = FPlatformTime::Seconds();
+			Build(Items, TypeIndices);
+			BestBuildSeconds = FMath::Min(BestBuildSeconds, FPlatformTime::Seconds() - Start);
+			BuildCounts = GetAllocationCounts() - Before;
+		}
+
+		// Calls
+		TArray<ElementType> Items;
+		Items.Reserve(NumItems);
+		Build(Items, TypeIndices);
+		Sink = Sink + Call(Items);
+
+		double BestCallSeconds = UE_DOUBLE_BIG_NUMBER;
+		for (int32 Repeat = 0; Repeat < Settings.Repeats; ++Repeat)
+		{
+			const FAllocationCounts Before = GetAllocationCounts();
+			const double Start = FPlatformTime::Seconds();
+			int64 Checksum = 0;
+			for (int32 Pass = 0; Pass < Settings.Passes; ++Pass)
+			{
+				Checksum += Call(Items);
+			}
+			BestCallSeconds = FMath::Min(BestCallSeconds, FPlatformTime::Seconds() - Start);
+			Result.CallAllocations = (GetAllocationCounts() - Before).Allocations;
+			Sink = Sink + Checksum;
+		}
+
+		Result.NsPerCall = BestCallSeconds * 1e9 / (static_cast<double>(NumItems) * Settings.Passes);
+		Result.ConstructNsPerItem = BestBuildSeconds * 1e9 / NumItems;
+		Result.BytesPerItem = sizeof(ElementType) + static_cast<double>(BuildCounts.Bytes) / NumItems;
+		Result.AllocationsPerItem = static_cast<double>(BuildCounts.Allocations) / NumItems;
+		return Result;
+	}
+
+	// Runs every mechanism on one call site
+	static void RunCallSite(const FSettings& Settings, const TCHAR* CallSite, TConstArrayView<uint8> TypeIndices, UDispatchBenchmarkTarget* Target, TArray<FResult>& OutResults)
+	{
+		using FBenchProxy = pro::proxy<FBenchFacade>;
+		OutResults.Add(RunCase<FBenchProxy>(Settings, TEXT("proxy"), CallSite, TypeIndices,
+			[](TArray<FBenchProxy>& Items, TConstArrayView<uint8> Types)
+			{
+				for (uint8 Type : Types)
+				{
+					VisitOp(Type, [&Items](const auto& Op) { Items.Add(pro::make_proxy<FBenchFacade>(Op)); });
+				}
+			},
+			[](TArray<FBenchProxy>& Items)
+			{
+				int64 Sum = 0;
+				int32 X = 0;
+				for (FBenchProxy& Item : Items)
+				{
+					Sum += (*Item)(X++);
+				}
+				return Sum;
+			}));
+
+		OutResults.Add(RunCase<TUniquePtr<IBenchOp>>(Settings, TEXT("virtual"), CallSite, TypeIndices,
+			[](TArray<TUniquePtr<IBenchOp>>& Items, TConstArrayView<uint8> Types)
+			{
+				for (uint8 Type : Types)
+				{
+					VisitOp(Type, [&Items](const auto& Op)
+					{
+						Items.Add(MakeUnique<TVirtualBenchOp<std::decay_t<decltype(Op)>::Index>>());
+					});
+				}
+			},
+			[](TArray<TUniquePtr<IBenchOp>>& Items)
+			{
+				int64 Sum = 0;
+				int32 X = 0;
+				for (const TUniquePtr<IBenchOp>& Item : Items)
+				{
+					Sum += Item->Call(X++);
+				}
+				return Sum;
+			}));
+
+		OutResults.Add(RunCase<TFunction<int32(int32)>>(Settings, TEXT("TFunction"), CallSite, TypeIndices,
+			[](TArray<TFunction<int32(int32)>>& Items, TConstArrayView<uint8> Types)
+			{
+				for (uint8 Type : Types)
+				{
+					VisitOp(Type, [&Items](const auto& Op) { Items.Add(Op); });
+				}
+			},
+			[](TArray<TFunction<int32(int32)>>& Items)
+			{
+				int64 Sum = 0;
+				int32 X = 0;
+				for (const TFunction<int32(int32)>& Item : Items)
+				{
+					Sum += Item(X++);
+				}
+				return Sum;
+			}));
+
+		OutResults.Add(RunCase<TFunctionRef<int32(int32)>>(Settings, TEXT("TFunctionRef"), CallSite, TypeIndices,
+			[](TArray<TFunctionRef<int32(int32)>>& Items, TConstArrayView<uint8> Types)
+			{
+				for (uint8 Type : Types)
+				{
+					VisitOp(Type, [&Items](const auto& Op) { Items.Add(Op); });
+				}
+			},
+			[](TArray<TFunctionRef<int32(int32)>>& Items)
+			{
+				int64 Sum = 0;
+				int32 X = 0;
+				for (const TFunctionRef<int32(int32)>& Item : Items)
+				{
+					Sum += Item(X++);
+				}
+				return Sum;
+			}));
+
+		OutResults.Add(RunCase<std::function<int32(int32)>>(Settings, TEXT("std::function"), CallSite, TypeIndices,
+			[](TArray<std::function<int32(int32)>>& Items, TConstArrayView<uint8> Types)
+			{
+				for (uint8 Type : Types)
+				{
+					VisitOp(Type, [&Items](const auto& Op) { Items.Add(std::function<int32(int32)>(Op)); });
+				}
+			},
+			[](TArray<std::function<int32(int32)>>& Items)
+			{
+				int64 Sum = 0;
+				int32 X = 0;
+				for (const std::function<int32(int32)>& Item : Items)
+				{
+					Sum += Item(X++);
+				}
+				return Sum;
+			}));
+
+		OutResults.Add(RunCase<FBenchDelegate>(Settings, TEXT("delegate"), CallSite, TypeIndices,
+			[](TArray<FBenchDelegate>& Items, TConstArrayView<uint8> Types)
+			{
+				for (uint8 Type : Types)
+				{
+					VisitOp(Type, [&Items](const auto& Op) { Items.Add(FBenchDelegate::CreateLambda(Op)); });
+				}
+			},
+			[](TArray<FBenchDelegate>& Items)
+			{
+				int64 Sum = 0;
+				int32 X = 0;
+				for (const FBenchDelegate& Item : Items)
+				{
+					Sum += Item.Execute(X++);
+				}
+				return Sum;
+			}));
+
+		// Dynamic delegates can only bind UFunctions, they have no megamorphic variant
+		if (TypeIndices.ContainsByPredicate([](uint8 Type) { return Type != 0; }))
+		{
+			return;
+		}
+
+		OutResults.Add(RunCase<FDispatchBenchmarkDynamicEvent>(Settings, TEXT("dynamic_multicast_delegate"), CallSite, TypeIndices,
+			[Target](TArray<FDispatchBenchmarkDynamicEvent>& Items, TConstArrayView<uint8> Types)
+			{
+				for (int32 Index = 0; Index < Types.Num(); ++Index)
+				{
+					FDispatchBenchmarkDynamicEvent& Event = Items.AddDefaulted_GetRef();
+					Event.AddDynamic(Target, &UDispatchBenchmarkTarget::OnValue);
+				}
+			},
+			[Target](TArray<FDispatchBenchmarkDynamicEvent>& Items)
+			{
+				Target->Sum = 0;
+				int32 X = 0;
+				for (const FDispatchBenchmarkDynamicEvent& Item : Items)
+				{
+					Item.Broadcast(X++);
+				}
+				return Target->Sum;
+			}));
+	}
+
+	static TSharedRef<FJsonObject> ToJson(const FResult& Result)
+	{
+		TSharedRef<FJsonObject> JsonResult = MakeShared<FJsonObject>();
+		JsonResult->SetStringField(TEXT("name"), Result.Name);
+		JsonResult->SetStringField(TEXT("call_site"), Result.CallSite);
+		JsonResult->SetNumberField(TEXT("ns_per_call"), Result.NsPerCall);
+		JsonResult->SetNumberField(TEXT("construct_ns_per_item"), Result.ConstructNsPerItem);
+		JsonResult->SetNumberField(TEXT("inline_bytes"), Result.InlineBytes);
+		JsonResult->SetNumberField(TEXT("bytes_per_item"), Result.BytesPerItem);
+		JsonResult->SetNumberField(TEXT("allocations_per_item"), Result.AllocationsPerItem);
+		JsonResult->SetNumberField(TEXT("call_allocations"), Result.CallAllocations);
+		return JsonResult;
+	}
+}
+
+UDispatchBenchmarkCommandlet::UDispatchBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UDispatchBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace DispatchBenchmark;
+
+	FSettings Settings;
+	FParse::Value(*Params, TEXT("Items="), Settings.Items);
+	FParse::Value(*Params, TEXT("Passes="), Settings.Passes);
+	FParse::Value(*Params, TEXT("Repeats="), Settings.Repeats);
+	Settings.Items = FMath::Max(Settings.Items, 1);
+	Settings.Passes = FMath::Max(Settings.Passes, 1);
+	Settings.Repeats = FMath::Max(Settings.Repeats, 1);
+
+	FString OutputPath;
+	if (!FParse::Value(*Params, TEXT("Output="), OutputPath))
+	{
+		OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("DispatchBenchmark_%s.json"), *FDateTime::Now().ToString());
+	}
+
+	// Same type everywhere for the monomorphic site, fixed seed shuffle of every type for the megamorphic one
+	TArray<uint8> MonomorphicTypes;
+	MonomorphicTypes.Init(0, Settings.Items);
+
+	TArray<uint8> MegamorphicTypes;
+	MegamorphicTypes.SetNumUninitialized(Settings.Items);
+	FRandomStream Random(0x5EED);
+	for (uint8& Type : MegamorphicTypes)
+	{
+		Type = static_cast<uint8>(Random.RandHelper(NumOpTypes));
+	}
+
+	UDispatchBenchmarkTarget* Target = NewObject<UDispatchBenchmarkTarget>();
+	Target->AddToRoot();
+
+	// Count the allocations of this thread only for the duration of the run
+	FMalloc* PreviousMalloc = GMalloc;
+	if (!CountingMalloc)
+	{
+		CountingMalloc = new FCountingMalloc(PreviousMalloc, FPlatformTLS::GetCurrentThreadId());
+	}
+	GMalloc = CountingMalloc;
+
+	TArray<FResult> Results;
+	RunCallSite(Settings, TEXT("monomorphic"), MonomorphicTypes, Target, Results);
+	RunCallSite(Settings, TEXT("megamorphic"), MegamorphicTypes, Target, Results);
+
+	GMalloc = PreviousMalloc;
+	Target->RemoveFromRoot();
+
+	TArray<TSharedPtr<FJsonValue>> JsonResults;
+	for (const FResult& Result : Results)
+	{
+		UE_LOG(LogTemp, Display, TEXT("%-28s %-12s %8.2f ns/call %8.2f ns/construct %7.1f bytes %5.2f allocs"),
+		       *Result.Name, *Result.CallSite, Result.NsPerCall, Result.ConstructNsPerItem, Result.BytesPerItem, Result.AllocationsPerItem);
+		JsonResults.Add(MakeShared<FJsonValueObject>(ToJson(Result)));
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("items"), Settings.Items);
+	Root->SetNumberField(TEXT("passes"), Settings.Passes);
+	Root->SetNumberField(TEXT("repeats"), Settings.Repeats);
+	Root->SetNumberField(TEXT("megamorphic_types"), NumOpTypes);
+	Root->SetArrayField(TEXT("results"), JsonResults);
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Dispatch benchmark could not write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("Dispatch benchmark results written to %s"), *OutputPath);
+	return 0;
+}
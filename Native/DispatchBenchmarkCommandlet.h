@@ -0,0 +1,45 @@
+// https://github.com/microsoft/proxy/blob/main/proxy.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "DispatchBenchmarkCommandlet.generated.h"
+
+// Dynamic multicast event measured by the benchmark
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDispatchBenchmarkDynamicEvent, int32, Value);
+
+// Object bound to the dynamic delegates of the benchmark
+UCLASS(Transient)
+class GAME_API UDispatchBenchmarkTarget : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION()
+	void OnValue(int32 Value) { Sum += Value * 2 + 1; }
+
+	int64 Sum = 0;
+};
+
+// Measures the cost of the dispatch mechanisms we can use for callbacks and events:
+// pro::proxy facades, virtual interfaces, TFunction, TFunctionRef, std::function, single-cast delegates
+// and dynamic multicast delegates.
+// Every case builds Items callables and calls them in a loop, on a monomorphic call site (every callable has
+// the same type) and on a megamorphic one (8 types in random order, dynamic delegates only have the monomorphic site).
+// Reported per case: ns per call, ns per construction, bytes per callable (inline size + heap), heap allocations
+// per construction and per call. Allocations are counted by wrapping GMalloc for the duration of the run.
+// Runs headless:
+//   UnrealEditor-Cmd <Project> -run=DispatchBenchmark [-Items=1024] [-Passes=200] [-Repeats=5] [-Output=<File.json>]
+// The JSON is written to Saved/Benchmarks unless -Output is set.
+UCLASS()
+class GAME_API UDispatchBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UDispatchBenchmarkCommandlet();
+
+	// UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+};
@@ -1,5 +1,8 @@
 // https://github.com/microsoft/proxy/blob/main/proxy.h
 
+#include "ProxyEventChannel.h"
+#include "ProxyBatchContainer.h"
+
 UFUNCTION(BlueprintCallable, Category = "ProxyTest")
 	void TestProxy();
 
@@ -21,4 +24,26 @@ void ACharacter::TestProxy()
 
 	// Write log
 	UE_LOG(LogTemp, Warning, TEXT("Proxy Test Result: %d"), result);
+
+	// same idea as a native event channel, listeners are stored inline without allocating
+	TProxyEventChannel<int> Channel;
+	FProxyEventHandle Handle = Channel.Add([this](int x)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Proxy Channel Value: %d (%s)"), x, *GetName());
+	});
+	Channel.Broadcast(result);
+	Channel.Remove(Handle);
+
+	// heterogeneous objects updated type by type, each batch is a direct call loop
+	struct FDamageOverTime { float DamagePerSecond = 5.0f; float Total = 0.0f; void Update(float DeltaTime) { Total += DamagePerSecond * DeltaTime; } };
+	struct FSpeedBuff { float Remaining = 3.0f; void Update(float DeltaTime) { Remaining -= DeltaTime; } };
+
+	TProxyBatchContainer<float> Effects;
+	FProxyBatchHandle Burn = Effects.Emplace<FDamageOverTime>();
+	FProxyBatchHandle Haste = Effects.Emplace<FSpeedBuff>();
+	Effects.Update(0.5f);
+	Effects.Get(Haste)->Update(0.5f);
+	Effects.Remove(Burn);
+
+	UE_LOG(LogTemp, Warning, TEXT("Proxy Batch Remaining: %f"), Effects.GetTyped<FSpeedBuff>(Haste)->Remaining);
 }
@@ -0,0 +1,362 @@
+// https://github.com/microsoft/proxy/blob/main/proxy.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "Templates/UnrealTemplate.h"
+#include "proxy.h"
+
+namespace ProxyBatch
+{
+	// Objects stored in a TProxyBatchContainer implement Update(ArgTypes...)
+	PRO_DEF_MEM_DISPATCH(FMemUpdate, Update);
+}
+
+// Handle of an object stored in a TProxyBatchContainer, stays valid until the object is removed
+struct FProxyBatchHandle
+{
+	uint32 Index = 0;
+
+	// 0 is never used by a live object
+	uint32 Generation = 0;
+
+	bool IsValid() const { return Generation != 0; }
+	void Reset() { Generation = 0; }
+};
+
+// Container for thousands of heterogeneous objects updated every frame (damage over time, buffs, status applicators...).
+// Objects are grouped by concrete type, each type keeps its objects packed in fixed-size chunks, so an update walks
+// contiguous memory and calls ObjectType::Update directly: each type batch is one monomorphic loop with no indirect call
+// per object. A pro::proxy view of any object is still available through its handle when the caller does not know its type.
+// Removing swaps the last object of the type into the freed place, handles go through a slot table so they stay stable.
+// Objects must be movable. Adding or removing during an update is not allowed.
+template<typename... ArgTypes>
+class TProxyBatchContainer
+{
+public:
+	// declare facade: what callers see of an object they do not know the type of
+	struct FFacade : pro::facade_builder
+		::add_convention<ProxyBatch::FMemUpdate, void(ArgTypes...)>
+		::build {};
+
+	// Non-owning view of an object, invalidated when any object of the same type is removed
+	using FProxy = pro::proxy<FFacade>;
+
+	// Target size of the chunks, at least one object per chunk
+	static constexpr int32 ChunkBytes = 16 * 1024;
+
+	TProxyBatchContainer() = default;
+	TProxyBatchContainer(const TProxyBatchContainer&) = delete;
+	TProxyBatchContainer& operator=(const TProxyBatchContainer&) = delete;
+
+	~TProxyBatchContainer()
+	{
+		Reset();
+		for (FTypeGroup& Group : Groups)
+		{
+			Group.FreeChunks();
+		}
+	}
+
+	// Constructs an object in the chunks of its type
+	template<typename ObjectType, typename... ConstructorArgTypes>
+	FProxyBatchHandle Emplace(ConstructorArgTypes&&... Args)
+	{
+		checkf(!bUpdating, TEXT("Objects cannot be added during an update"));
+
+		const int32 GroupIndex = FindOrAddGroup<ObjectType>();
+		FTypeGroup& Group = Groups[GroupIndex];
+		const int32 DenseIndex = Group.Num;
+		if (DenseIndex == Group.Chunks.Num() * Group.ObjectsPerChunk)
+		{
+			Group.Chunks.Add(FMemory::Malloc(Group.ObjectsPerChunk * sizeof(ObjectType), alignof(ObjectType)));
+		}
+		new (Group.GetObject(DenseIndex)) ObjectType(Forward<ConstructorArgTypes>(Args)...);
+		++Group.Num;
+
+		const uint32 SlotIndex = AllocateSlot();
+		FHandleSlot& Slot = Slots[SlotIndex];
+		Slot.GroupIndex = GroupIndex;
+		Slot.DenseIndex = DenseIndex;
+		Group.SlotIndices.Add(SlotIndex);
+		++NumObjects;
+
+		return FProxyBatchHandle{ SlotIndex, Slot.Generation };
+	}
+
+	// Destroys an object, the handle is reset
+	bool Remove(FProxyBatchHandle& Handle)
+	{
+		checkf(!bUpdating, TEXT("Objects cannot be removed during an update"));
+
+		const FHandleSlot* Slot = FindSlot(Handle);
+		if (!Slot)
+		{
+			return false;
+		}
+
+		FTypeGroup& Group = Groups[Slot->GroupIndex];
+		const int32 DenseIndex = Slot->DenseIndex;
+		const int32 LastIndex = Group.Num - 1;
+		void* Object = Group.GetObject(DenseIndex);
+		Group.Destroy(Object);
+
+		// Keep the type packed, the last object takes over the freed place
+		if (DenseIndex != LastIndex)
+		{
+			Group.Relocate(Object, Group.GetObject(LastIndex));
+			const uint32 MovedSlotIndex = Group.SlotIndices[LastIndex];
+			Group.SlotIndices[DenseIndex] = MovedSlotIndex;
+			Slots[MovedSlotIndex].DenseIndex = DenseIndex;
+		}
+		Group.SlotIndices.Pop(EAllowShrinking::No);
+		--Group.Num;
+		--NumObjects;
+
+		FreeSlot(Handle.Index);
+		Handle.Reset();
+		return true;
+	}
+
+	// Returns a view of an object, empty if the handle is not valid anymore
+	FProxy Get(FProxyBatchHandle Handle) const
+	{
+		const FHandleSlot* Slot = FindSlot(Handle);
+		if (!Slot)
+		{
+			return FProxy();
+		}
+		const FTypeGroup& Group = Groups[Slot->GroupIndex];
+		return Group.MakeProxy(Group.GetObject(Slot->DenseIndex));
+	}
+
+	// Returns an object if the handle is valid and the object has this exact type
+	template<typename ObjectType>
+	ObjectType* GetTyped(FProxyBatchHandle Handle) const
+	{
+		const FHandleSlot* Slot = FindSlot(Handle);
+		if (!Slot || Groups[Slot->GroupIndex].TypeKey != TTypeOps<ObjectType>::GetKey())
+		{
+			return nullptr;
+		}
+		return static_cast<ObjectType*>(Groups[Slot->GroupIndex].GetObject(Slot->DenseIndex));
+	}
+
+	// Updates every object, one type after the other
+	void Update(ArgTypes... Args)
+	{
+		TGuardValue<bool> UpdateGuard(bUpdating, true);
+		for (FTypeGroup& Group : Groups)
+		{
+			for (int32 ChunkIndex = 0; ChunkIndex < Group.Chunks.Num(); ++ChunkIndex)
+			{
+				const int32 Count = Group.GetChunkCount(ChunkIndex);
+				if (Count == 0)
+				{
+					break;
+				}
+				Group.UpdateRange(Group.Chunks[ChunkIndex], Count, Args...);
+			}
+		}
+	}
+
+	// Updates every object on the task graph, one task per chunk so a large type is split too.
+	// Objects must not touch each other or shared state without synchronization.
+	void ParallelUpdate(ArgTypes... Args)
+	{
+		struct FBatch
+		{
+			const FTypeGroup* Group;
+			void* Chunk;
+			int32 Count;
+		};
+
+		TArray<FBatch, TInlineAllocator<64>> Batches;
+		for (const FTypeGroup& Group : Groups)
+		{
+			for (int32 ChunkIndex = 0; ChunkIndex < Group.Chunks.Num(); ++ChunkIndex)
+			{
+				const int32 Count = Group.GetChunkCount(ChunkIndex);
+				if (Count == 0)
+				{
+					break;
+				}
+				Batches.Add(FBatch{ &Group, Group.Chunks[ChunkIndex], Count });
+			}
+		}
+
+		TGuardValue<bool> UpdateGuard(bUpdating, true);
+		ParallelFor(Batches.Num(), [&Batches, &Args...](int32 BatchIndex)
+		{
+			const FBatch& Batch = Batches[BatchIndex];
+			Batch.Group->UpdateRange(Batch.Chunk, Batch.Count, Args...);
+		});
+	}
+
+	// Destroys every object, outstanding handles become invalid. Chunks are kept for reuse.
+	void Reset()
+	{
+		checkf(!bUpdating, TEXT("Objects cannot be removed during an update"));
+
+		for (FTypeGroup& Group : Groups)
+		{
+			for (int32 DenseIndex = 0; DenseIndex < Group.Num; ++DenseIndex)
+			{
+				Group.Destroy(Group.GetObject(DenseIndex));
+			}
+			for (uint32 SlotIndex : Group.SlotIndices)
+			{
+				FreeSlot(SlotIndex);
+			}
+			Group.SlotIndices.Reset();
+			Group.Num = 0;
+		}
+		NumObjects = 0;
+	}
+
+	int32 Num() const { return NumObjects; }
+	int32 NumTypes() const { return Groups.Num(); }
+
+private:
+	// Typed functions of one object type
+	template<typename ObjectType>
+	struct TTypeOps
+	{
+		// Written to so the linker can never fold the keys of two types together
+		static inline uint8 Key = 0;
+
+		static const void* GetKey() { return &Key; }
+
+		static void UpdateRange(void* Chunk, int32 Count, ArgTypes... Args)
+		{
+			ObjectType* Objects = static_cast<ObjectType*>(Chunk);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Objects[Index].Update(Args...);
+			}
+		}
+
+		static void Relocate(void* Destination, void* Source)
+		{
+			new (Destination) ObjectType(MoveTemp(*static_cast<ObjectType*>(Source)));
+			static_cast<ObjectType*>(Source)->~ObjectType();
+		}
+
+		static void Destroy(void* Object)
+		{
+			static_cast<ObjectType*>(Object)->~ObjectType();
+		}
+
+		static FProxy MakeProxy(void* Object)
+		{
+			return FProxy(static_cast<ObjectType*>(Object));
+		}
+	};
+
+	// Objects of one concrete type, packed from the first chunk
+	struct FTypeGroup
+	{
+		const void* TypeKey = nullptr;
+		int32 ObjectSize = 0;
+		int32 ObjectsPerChunk = 0;
+		int32 Num = 0;
+		TArray<void*> Chunks;
+
+		// Handle slot of each object, by dense index
+		TArray<uint32> SlotIndices;
+
+		void (*UpdateRange)(void* Chunk, int32 Count, ArgTypes... Args) = nullptr;
+		void (*Relocate)(void* Destination, void* Source) = nullptr;
+		void (*Destroy)(void* Object) = nullptr;
+		FProxy (*MakeProxy)(void* Object) = nullptr;
+
+		void* GetObject(int32 DenseIndex) const
+		{
+			return static_cast<uint8*>(Chunks[DenseIndex / ObjectsPerChunk]) + (DenseIndex % ObjectsPerChunk) * ObjectSize;
+		}
+
+		int32 GetChunkCount(int32 ChunkIndex) const
+		{
+			return FMath::Clamp(Num - ChunkIndex * ObjectsPerChunk, 0, ObjectsPerChunk);
+		}
+
+		void FreeChunks()
+		{
+			for (void* Chunk : Chunks)
+			{
+				FMemory::Free(Chunk);
+			}
+			Chunks.Reset();
+		}
+	};
+
+	struct FHandleSlot
+	{
+		uint32 Generation = 1;
+		int32 GroupIndex = INDEX_NONE;
+
+		// Dense index in the group while used, next free slot otherwise
+		int32 DenseIndex = INDEX_NONE;
+	};
+
+	template<typename ObjectType>
+	int32 FindOrAddGroup()
+	{
+		using FOps = TTypeOps<ObjectType>;
+		if (const int32* GroupIndex = GroupIndexByType.Find(FOps::GetKey()))
+		{
+			return *GroupIndex;
+		}
+
+		FTypeGroup& Group = Groups.AddDefaulted_GetRef();
+		Group.TypeKey = FOps::GetKey();
+		Group.ObjectSize = sizeof(ObjectType);
+		Group.ObjectsPerChunk = FMath::Max(1, ChunkBytes / static_cast<int32>(sizeof(ObjectType)));
+		Group.UpdateRange = &FOps::UpdateRange;
+		Group.Relocate = &FOps::Relocate;
+		Group.Destroy = &FOps::Destroy;
+		Group.MakeProxy = &FOps::MakeProxy;
+		return GroupIndexByType.Add(FOps::GetKey(), Groups.Num() - 1);
+	}
+
+	const FHandleSlot* FindSlot(FProxyBatchHandle Handle) const
+	{
+		if (!Handle.IsValid() || !Slots.IsValidIndex(Handle.Index))
+		{
+			return nullptr;
+		}
+		const FHandleSlot& Slot = Slots[Handle.Index];
+		return Slot.Generation == Handle.Generation && Slot.GroupIndex != INDEX_NONE ? &Slot : nullptr;
+	}
+
+	uint32 AllocateSlot()
+	{
+		if (FirstFreeSlot == INDEX_NONE)
+		{
+			return Slots.AddDefaulted();
+		}
+		const uint32 SlotIndex = FirstFreeSlot;
+		FirstFreeSlot = Slots[SlotIndex].DenseIndex;
+		return SlotIndex;
+	}
+
+	void FreeSlot(uint32 SlotIndex)
+	{
+		FHandleSlot& Slot = Slots[SlotIndex];
+		if (++Slot.Generation == 0)
+		{
+			Slot.Generation = 1;
+		}
+		Slot.GroupIndex = INDEX_NONE;
+		Slot.DenseIndex = FirstFreeSlot;
+		FirstFreeSlot = SlotIndex;
+	}
+
+	TArray<FTypeGroup> Groups;
+	TMap<const void*, int32> GroupIndexByType;
+	TArray<FHandleSlot> Slots;
+	int32 FirstFreeSlot = INDEX_NONE;
+	int32 NumObjects = 0;
+	bool bUpdating = false;
+};
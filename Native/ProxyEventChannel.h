@@ -0,0 +1,178 @@
+// https://github.com/microsoft/proxy/blob/main/proxy.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProxyEventHandle.h"
+#include "proxy.h"
+
+// Native event channel whose listeners are pro::proxy objects stored in one contiguous array.
+// Callables up to InlineListenerSize bytes (a lambda capturing a few pointers, a weak object pointer and a member
+// function pointer...) are stored inside the proxy itself, so adding them does not allocate and calling them is
+// one indirect call with no reflection, no UFunction lookup and no delegate instance indirection.
+// Listeners may add or remove listeners (including themselves) during a broadcast:
+// removed listeners are not called anymore, added listeners are first called on the next broadcast.
+// Game thread only, like the delegates it replaces on hot paths. Not exposed to Blueprint.
+template<typename... ArgTypes>
+class TProxyEventChannel
+{
+public:
+	static constexpr std::size_t InlineListenerSize = 4 * sizeof(void*);
+
+	// declare facade: callable with the event arguments, stored inline up to InlineListenerSize
+	struct FListenerFacade : pro::facade_builder
+		::add_convention<pro::operator_dispatch<"()", false>, void(ArgTypes...)>
+		::template restrict_layout<InlineListenerSize>
+		::build {};
+
+	using FListener = pro::proxy<FListenerFacade>;
+
+	TProxyEventChannel() = default;
+	TProxyEventChannel(const TProxyEventChannel&) = delete;
+	TProxyEventChannel& operator=(const TProxyEventChannel&) = delete;
+
+	// Adds a callable listener, returns the handle used to remove it
+	template<typename CallableType>
+	FProxyEventHandle Add(CallableType&& Callable)
+	{
+		const FProxyEventHandle Handle{ NextId++ };
+		if (NextId == 0)
+		{
+			NextId = 1;
+		}
+
+		// Adding to the array while it is being broadcast could move a listener that is running
+		TArray<FEntry>& Target = BroadcastDepth > 0 ? PendingListeners : Listeners;
+		Target.Add(FEntry{ pro::make_proxy<FListenerFacade>(Forward<CallableType>(Callable)), Handle.Id });
+		return Handle;
+	}
+
+	// Adds a member function of a UObject, the listener does nothing once the object is destroyed
+	template<typename ObjectType>
+	FProxyEventHandle AddUObject(ObjectType* Object, void (ObjectType::*Function)(ArgTypes...))
+	{
+		return Add([WeakObject = TWeakObjectPtr<ObjectType>(Object), Function](ArgTypes... Args)
+		{
+			if (ObjectType* Target = WeakObject.Get())
+			{
+				(Target->*Function)(Args...);
+			}
+		});
+	}
+
+	// Removes a listener, safe to call from inside a broadcast
+	bool Remove(FProxyEventHandle& Handle)
+	{
+		if (!Handle.IsValid())
+		{
+			return false;
+		}
+
+		const uint32 Id = Handle.Id;
+		Handle.Reset();
+
+		if (RemoveFrom(PendingListeners, Id, false))
+		{
+			return true;
+		}
+		return RemoveFrom(Listeners, Id, BroadcastDepth > 0);
+	}
+
+	// Calls every listener in the order they were added
+	void Broadcast(ArgTypes... Args)
+	{
+		++BroadcastDepth;
+
+		// The array never grows or shrinks during a broadcast, so the running listener never moves
+		const int32 NumListeners = Listeners.Num();
+		for (int32 Index = 0; Index < NumListeners; ++Index)
+		{
+			FEntry& Entry = Listeners[Index];
+			if (Entry.Id != 0)
+			{
+				(*Entry.Listener)(Args...);
+			}
+		}
+
+		if (--BroadcastDepth == 0)
+		{
+			FlushPendingChanges();
+		}
+	}
+
+	int32 Num() const { return Listeners.Num() + PendingListeners.Num() - NumRemovedDuringBroadcast; }
+	bool IsBound() const { return Num() > 0; }
+
+	// Removes every listener, safe to call from inside a broadcast
+	void Clear()
+	{
+		PendingListeners.Reset();
+		if (BroadcastDepth > 0)
+		{
+			for (FEntry& Entry : Listeners)
+			{
+				if (Entry.Id != 0)
+				{
+					Entry.Id = 0;
+					++NumRemovedDuringBroadcast;
+				}
+			}
+			return;
+		}
+		Listeners.Reset();
+	}
+
+private:
+	struct FEntry
+	{
+		FListener Listener;
+
+		// 0 once removed during a broadcast, the entry is destroyed when the broadcast ends
+		uint32 Id;
+	};
+
+	bool RemoveFrom(TArray<FEntry>& Entries, uint32 Id, bool bDefer)
+	{
+		const int32 Index = Entries.IndexOfByPredicate([Id](const FEntry& Entry) { return Entry.Id == Id; });
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		if (bDefer)
+		{
+			// The listener may be the one running, it is destroyed after the broadcast
+			Entries[Index].Id = 0;
+			++NumRemovedDuringBroadcast;
+		}
+		else
+		{
+			Entries.RemoveAt(Index);
+		}
+		return true;
+	}
+
+	void FlushPendingChanges()
+	{
+		if (NumRemovedDuringBroadcast > 0)
+		{
+			Listeners.RemoveAll([](const FEntry& Entry) { return Entry.Id == 0; });
+			NumRemovedDuringBroadcast = 0;
+		}
+		if (PendingListeners.Num() > 0)
+		{
+			Listeners.Append(MoveTemp(PendingListeners));
+			PendingListeners.Reset();
+		}
+	}
+
+	// Contiguous listeners, in the order they were added
+	TArray<FEntry> Listeners;
+
+	// Listeners added during a broadcast, moved to Listeners when it ends
+	TArray<FEntry> PendingListeners;
+
+	int32 BroadcastDepth = 0;
+	int32 NumRemovedDuringBroadcast = 0;
+	uint32 NextId = 1;
+};
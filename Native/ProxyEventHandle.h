@@ -0,0 +1,13 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Handle of a listener added to a TProxyEventChannel, 0 is never used.
+// Kept apart from the channel so classes can store handles without including proxy.h
+struct FProxyEventHandle
+{
+	uint32 Id = 0;
+
+	bool IsValid() const { return Id != 0; }
+	void Reset() { Id = 0; }
+};
@@ -0,0 +1,100 @@
+#include "StatusActionRuleSet.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(StatusActionRuleSet)
+
+namespace StatusActionRuleSet
+{
+   /** Number of actions evaluated per iteration, the packed arrays are padded to it */
+   static constexpr int32 BatchSize = 16;
+}
+
+void UStatusActionRuleSet::PostLoad()
+{
+   Super::PostLoad();
+   CompileRules();
+}
+
+#if WITH_EDITOR
+void UStatusActionRuleSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+   Super::PostEditChangeProperty(PropertyChangedEvent);
+   CompileRules();
+}
+#endif
+
+void UStatusActionRuleSet::CompileRules()
+{
+   using namespace StatusActionRuleSet;
+
+   const int32 PaddedNum = Align(Actions.Num(), BatchSize);
+
+   // Padding requires and prohibits every flag at once, so it never passes
+   PackedMustHave.Init(0xFF, PaddedNum);
+   PackedMustNotHave.Init(0xFF, PaddedNum);
+   ActionIndexByName.Reset();
+
+   for (int32 ActionIndex = 0; ActionIndex < Actions.Num(); ++ActionIndex)
+   {
+       const FStatusActionRule& Rule = Actions[ActionIndex];
+       PackedMustHave[ActionIndex] = Rule.MustHaveFlags;
+       PackedMustNotHave[ActionIndex] = Rule.MustNotHaveFlags;
+       ActionIndexByName.Add(Rule.ActionName, ActionIndex);
+   }
+
+   CompiledNumActions = Actions.Num();
+   ++CompiledVersion;
+}
+
+int32 UStatusActionRuleSet::FindActionIndex(FName ActionName) const
+{
+   ConditionalCompileRules();
+   const int32* ActionIndex = ActionIndexByName.Find(ActionName);
+   return ActionIndex ? *ActionIndex : INDEX_NONE;
+}
+
+void UStatusActionRuleSet::EvaluateAll(uint8 Flags, FStatusAllowedActions& OutAllowed) const
+{
+   using namespace StatusActionRuleSet;
+
+   ConditionalCompileRules();
+   const int32 PaddedNum = PackedMustHave.Num();
+   OutAllowed.Words.Reset();
+   OutAllowed.Words.AddZeroed(FMath::DivideAndRoundUp(PaddedNum, 32));
+
+   const uint8* MustHave = PackedMustHave.GetData();
+   const uint8* MustNotHave = PackedMustNotHave.GetData();
+
+   // Each batch of 16 actions fills one half of a 32-bit result word (little endian)
+   static_assert(PLATFORM_LITTLE_ENDIAN, "The allowed action bits are written as 16-bit halves");
+   uint16* AllowedBits = reinterpret_cast<uint16*>(OutAllowed.Words.GetData());
+
+#if PLATFORM_CPU_X86_FAMILY
+   // An action passes when (Flags & MustHave) == MustHave and (Flags & MustNotHave) == 0
+   const __m128i FlagsVector = _mm_set1_epi8(static_cast<char>(Flags));
+   const __m128i Zero = _mm_setzero_si128();
+   for (int32 Index = 0; Index < PaddedNum; Index += BatchSize)
+   {
+       const __m128i Must = _mm_loadu_si128(reinterpret_cast<const __m128i*>(MustHave + Index));
+       const __m128i MustNot = _mm_loadu_si128(reinterpret_cast<const __m128i*>(MustNotHave + Index));
+       const __m128i HasRequired = _mm_cmpeq_epi8(_mm_and_si128(FlagsVector, Must), Must);
+       const __m128i HasNoProhibited = _mm_cmpeq_epi8(_mm_and_si128(FlagsVector, MustNot), Zero);
+       AllowedBits[Index / BatchSize] = static_cast<uint16>(_mm_movemask_epi8(_mm_and_si128(HasRequired, HasNoProhibited)));
+   }
+#else
+   for (int32 Index = 0; Index < PaddedNum; Index += BatchSize)
+   {
+       uint16 Bits = 0;
+       for (int32 Lane = 0; Lane < BatchSize; ++Lane)
+       {
+           const uint8 Must = MustHave[Index + Lane];
+           const bool bAllowed = (Flags & Must) == Must && (Flags & MustNotHave[Index + Lane]) == 0;
+           Bits |= static_cast<uint16>(bAllowed) << Lane;
+       }
+       AllowedBits[Index / BatchSize] = Bits;
+   }
+#endif
+}
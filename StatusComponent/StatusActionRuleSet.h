@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "StatusActionRuleSet.generated.h"
+
+/**
+ * Status requirements of one named action (ability, interaction, UI button...)
+ */
+USTRUCT(BlueprintType)
+struct FStatusActionRule
+{
+  GENERATED_BODY()
+
+  /** Name used to query the action */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status")
+  FName ActionName;
+
+  /** Flags that must be present */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 MustHaveFlags = 0;
+
+  /** Flags that must not be present */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 MustNotHaveFlags = 0;
+};
+
+/**
+ * Result of evaluating every action of a rule set, one bit per action index
+ */
+struct FStatusAllowedActions
+{
+  TArray<uint32, TInlineAllocator<4>> Words;
+
+  FORCEINLINE bool IsAllowed(int32 ActionIndex) const
+  {
+    return ActionIndex >= 0 && (ActionIndex >> 5) < Words.Num() && ((Words[ActionIndex >> 5] >> (ActionIndex & 31)) & 1);
+  }
+};
+
+/**
+ * StatusActionRuleSet - Data asset that lists the status requirements of named actions
+ * The rules are compiled into two packed mask arrays (must have / must not have), padded to the
+ * vector width, so every action of the set is evaluated for a component in one vectorized pass.
+ * Assets compile on load and on edit, sets built at runtime compile on first use and whenever the number of actions
+ * changes. Code that edits existing actions in place must call CompileRules.
+ */
+UCLASS(BlueprintType)
+class GAME_API UStatusActionRuleSet : public UDataAsset
+{
+  GENERATED_BODY()
+
+public:
+  virtual void PostLoad() override;
+#if WITH_EDITOR
+  virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+  /**
+   * Returns the index of an action
+   * @param ActionName - Name of the action
+   * @return Action index, INDEX_NONE if the set has no such action
+   */
+  int32 FindActionIndex(FName ActionName) const;
+
+  /** Number of actions in the set */
+  FORCEINLINE int32 NumActions() const { return Actions.Num(); }
+
+  /** Incremented every time the rules are compiled, used to invalidate cached results */
+  FORCEINLINE uint32 GetCompiledVersion() const
+  {
+    ConditionalCompileRules();
+    return CompiledVersion;
+  }
+
+  /** Rebuilds the packed mask arrays and the name lookup, call it after editing Actions from code */
+  UFUNCTION(BlueprintCallable, Category = "Status")
+  void CompileRules();
+
+  /**
+   * Evaluates every action against a set of flags
+   * @param Flags - Status flags of the component
+   * @param OutAllowed - Receives one bit per action, set if the action can be performed
+   */
+  void EvaluateAll(uint8 Flags, FStatusAllowedActions& OutAllowed) const;
+
+  /** Actions of the set */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status")
+  TArray<FStatusActionRule> Actions;
+
+private:
+  /** Compiles the rules if they were never compiled or actions were added or removed since */
+  FORCEINLINE void ConditionalCompileRules() const
+  {
+    if (CompiledNumActions != Actions.Num())
+    {
+      const_cast<UStatusActionRuleSet*>(this)->CompileRules();
+    }
+  }
+
+  /** Required flags per action, padded with entries that never pass */
+  TArray<uint8> PackedMustHave;
+
+  /** Prohibited flags per action, padded with entries that never pass */
+  TArray<uint8> PackedMustNotHave;
+
+  /** Action index by name */
+  TMap<FName, int32> ActionIndexByName;
+
+  /** Number of actions at the last compilation, INDEX_NONE until the first one */
+  int32 CompiledNumActions = INDEX_NONE;
+
+  uint32 CompiledVersion = 0;
+};
@@ -1,17 +1,44 @@
 #include "StatusComponent.h"
+#include "StatusWorldSubsystem.h"
+#include "StatusReplicationManager.h"
+#include "StatusJournal.h"
+#include "StatusFlagsChangedChannel.h"
+#include "StatusTrace.h"
+#include "StatusDebugOverlay.h"
 #include "GameFramework/Character.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
 
 #include UE_INLINE_GENERATED_CPP_BY_NAME(StatusComponent)
 
 UStatusComponent::UStatusComponent()
 {
-   PrimaryComponentTick.bCanEverTick = false;
+   // Only ticks while deferred status events are pending
+   PrimaryComponentTick.bCanEverTick = true;
+   PrimaryComponentTick.bStartWithTickEnabled = false;
    StatusFlags = 0;
+
+   // UObject unique ids are recycled after garbage collection, this one is never reused
+   static std::atomic<uint32> NextStatusComponentId{ 1 };
+   StatusComponentId = NextStatusComponentId.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Out of line so the channel type is complete where it is destroyed
+UStatusComponent::~UStatusComponent() = default;
+
+FStatusFlagsChangedChannel& UStatusComponent::GetStatusFlagsChangedChannel()
+{
+   if (!StatusFlagsChangedChannel)
+   {
+       StatusFlagsChangedChannel = MakeUnique<FStatusFlagsChangedChannel>();
+   }
+   return *StatusFlagsChangedChannel;
 }
 
 void UStatusComponent::BeginPlay()
 {
    Super::BeginPlay();
+   SetTickGroup(StatusEventTickGroup);
    InitializeStatusComponent();
 }
 
@@ -22,12 +49,154 @@ void UStatusComponent::InitializeStatusComponent()
    {
 
    }
+
+   if (bAtomicStatusFlags)
+   {
+       AtomicState.store(StatusFlags);
+       NextAtomicVersion = 1;
+       bAtomicStateReady = true;
+   }
+
+   if (UWorld* World = GetWorld())
+   {
+       StatusStore = World->GetSubsystem<UStatusWorldSubsystem>();
+       if (StatusStore)
+       {
+           StatusStore->RegisterStatusComponent(this);
+
+           // Timed flags added before the component joined the store, skipped if the flag was removed since
+           for (const FPendingTimedFlag& Pending : PendingTimedFlags)
+           {
+               if (HasStatusFlag(Pending.Flag))
+               {
+                   ScheduleStatusFlagExpiry(Pending.Flag, Pending.Duration, Pending.Policy);
+               }
+           }
+
+           AActor* Owner = GetOwner();
+           if (bReplicateStatusFlags && StatusStore->IsReplicatingStatus() && Owner && Owner->GetIsReplicated() && Owner->HasAuthority())
+           {
+               StatusStore->AddReplicatedComponent(this);
+           }
+       }
+   }
+   PendingTimedFlags.Empty();
    OnStatusComponentInitialized.Broadcast();
 }
 
+void UStatusComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+   if (bAtomicStateReady)
+   {
+       DrainAtomicTransitions();
+   }
+   FlushStatusEvents();
+   if (StatusStore)
+   {
+       StatusStore->RemoveReplicatedComponent(this);
+       StatusStore->UnregisterStatusComponent(this);
+       StatusStore = nullptr;
+   }
+   Super::EndPlay(EndPlayReason);
+}
+
 void UStatusComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+   FlushStatusEvents();
+}
+
+void UStatusComponent::FlushStatusEvents()
+{
+   if (!bHasPendingStatusEvents) return;
+
+   bHasPendingStatusEvents = false;
+   SetComponentTickEnabled(false);
+
+   if (PendingEventBaseFlags != StatusFlags)
+   {
+       BroadcastStatusChange(PendingEventBaseFlags, StatusFlags);
+   }
+}
+
+// Atomic storage
+template <typename TransformType>
+void UStatusComponent::UpdateStatusFlags(TransformType&& Transform, EStatusChangeCause Cause)
+{
+   // Replicated and restored flags were already resolved when they were set
+   const bool bApplyRules = Cause != EStatusChangeCause::Replicated && Cause != EStatusChangeCause::Restored;
+   const UStatusTransitionRuleSet* Rules = bApplyRules ? TransitionRules.Get() : nullptr;
+   auto Resolve = [&Transform, Rules](uint8 OldFlags) -> uint8
+   {
+       const uint8 RequestedFlags = Transform(FStatusCoreFlagSet::FromBits(OldFlags)).GetWord(0);
+       return Rules ? Rules->ResolveTransition(OldFlags, RequestedFlags) : RequestedFlags;
+   };
+
+   if (!bAtomicStateReady)
+   {
+       CommitStatusFlags(Resolve(StatusFlags), Cause);
+       return;
+   }
+
+   // Flags live in the low byte, the upper 24 bits count transitions so the game thread can replay them in order
+   uint32 OldState = AtomicState.load(std::memory_order_relaxed);
+   uint32 NewState = 0;
+   uint8 NewFlags = 0;
+   do
+   {
+       NewFlags = Resolve(static_cast<uint8>(OldState));
+       if (NewFlags == static_cast<uint8>(OldState)) return;
+       NewState = ((OldState + 0x100) & 0xFFFFFF00) | NewFlags;
+   }
+   while (!AtomicState.compare_exchange_weak(OldState, NewState, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+   AtomicTransitionQueue.Enqueue(FAtomicTransition{ NewState >> 8, NewFlags, Cause });
+
+   if (IsInGameThread())
+   {
+       DrainAtomicTransitions();
+   }
+   else if (!bAtomicDrainScheduled.exchange(true))
+   {
+       AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<UStatusComponent>(this)]()
+       {
+           if (UStatusComponent* Component = WeakThis.Get())
+           {
+               Component->DrainAtomicTransitions();
+           }
+       });
+   }
+}
+
+void UStatusComponent::DrainAtomicTransitions()
+{
+   check(IsInGameThread());
+
+   // Listeners may change flags again, the outer call picks those transitions up
+   if (bDrainingAtomicTransitions) return;
+   TGuardValue<bool> DrainGuard(bDrainingAtomicTransitions, true);
+
+   // Cleared before dequeuing, so a transition enqueued after this point schedules a new drain
+   bAtomicDrainScheduled.store(false);
+
+   for (;;)
+   {
+       FAtomicTransition Transition;
+       while (AtomicTransitionQueue.Dequeue(Transition))
+       {
+           PendingAtomicTransitions.Add(Transition);
+       }
+
+       // A missing version means its thread won the CAS but has not enqueued yet, it schedules its own drain
+       const uint32 ExpectedVersion = NextAtomicVersion;
+       const int32 NextIndex = PendingAtomicTransitions.IndexOfByPredicate([ExpectedVersion](const FAtomicTransition& Pending) { return Pending.Version == ExpectedVersion; });
+       if (NextIndex == INDEX_NONE) break;
+
+       Transition = PendingAtomicTransitions[NextIndex];
+       PendingAtomicTransitions.RemoveAtSwap(NextIndex, 1, EAllowShrinking::No);
+       NextAtomicVersion = (NextAtomicVersion + 1) & 0xFFFFFF;
+       CommitStatusFlags(Transition.NewFlags, Transition.Cause);
+   }
 }
 
 // Single flag operations
@@ -35,24 +204,16 @@ void UStatusComponent::AddStatusFlag(EStatusFlags Flag)
 {
    if (!IsValidFlag(Flag)) return;
 
-   const uint8 FlagValue = static_cast<uint8>(Flag);
-   if (!HasStatusFlag(Flag))
-   {
-       StatusFlags |= FlagValue;
-       OnStatusFlagAdded.Broadcast(Flag);
-   }
+   const FStatusCoreFlagSet FlagSet = ToCoreFlagSet(static_cast<int32>(Flag));
+   UpdateStatusFlags([FlagSet](FStatusCoreFlagSet Flags) { return Flags | FlagSet; }, EStatusChangeCause::Add);
 }
 
 void UStatusComponent::ClearStatusFlag(EStatusFlags Flag)
 {
    if (!IsValidFlag(Flag)) return;
 
-   const uint8 FlagValue = static_cast<uint8>(Flag);
-   if (HasStatusFlag(Flag))
-   {
-       StatusFlags &= ~FlagValue;
-       OnStatusFlagRemoved.Broadcast(Flag);
-   }
+   const FStatusCoreFlagSet FlagSet = ToCoreFlagSet(static_cast<int32>(Flag));
+   UpdateStatusFlags([FlagSet](FStatusCoreFlagSet Flags) { return Flags & ~FlagSet; }, EStatusChangeCause::Remove);
 }
 
 // Multiple flag operations
@@ -60,142 +221,347 @@ void UStatusComponent::AddStatusFlags(int32 FlagsToAdd)
 {
    if (FlagsToAdd == 0) return;
 
-   const uint8 OldFlags = StatusFlags;
-   StatusFlags |= static_cast<uint8>(FlagsToAdd);
-
-   if (StatusFlags != OldFlags)
-   {
-       OnStatusFlagAdded.Broadcast(static_cast<EStatusFlags>(FlagsToAdd));
-   }
+   const FStatusCoreFlagSet FlagSet = ToCoreFlagSet(FlagsToAdd);
+   UpdateStatusFlags([FlagSet](FStatusCoreFlagSet Flags) { return Flags | FlagSet; }, EStatusChangeCause::Add);
 }
 
 void UStatusComponent::RemoveStatusFlags(int32 FlagsToRemove)
 {
    if (FlagsToRemove == 0) return;
 
-   const uint8 OldFlags = StatusFlags;
-   StatusFlags &= ~static_cast<uint8>(FlagsToRemove);
-
-   if (StatusFlags != OldFlags)
-   {
-       OnStatusFlagRemoved.Broadcast(static_cast<EStatusFlags>(FlagsToRemove));
-   }
+   const FStatusCoreFlagSet FlagSet = ToCoreFlagSet(FlagsToRemove);
+   UpdateStatusFlags([FlagSet](FStatusCoreFlagSet Flags) { return Flags & ~FlagSet; }, EStatusChangeCause::Remove);
 }
 
 void UStatusComponent::ToggleStatusFlags(int32 FlagsToToggle)
 {
    if (FlagsToToggle == 0) return;
 
-   const uint8 OldFlags = StatusFlags;
-   StatusFlags ^= static_cast<uint8>(FlagsToToggle);
-
-   if (StatusFlags != OldFlags)
-   {
-       const uint8 Added = (~OldFlags) & StatusFlags;
-       const uint8 Removed = OldFlags & (~StatusFlags);
-
-       if (Added) OnStatusFlagAdded.Broadcast(static_cast<EStatusFlags>(Added));
-       if (Removed) OnStatusFlagRemoved.Broadcast(static_cast<EStatusFlags>(Removed));
-   }
+   const FStatusCoreFlagSet FlagSet = ToCoreFlagSet(FlagsToToggle);
+   UpdateStatusFlags([FlagSet](FStatusCoreFlagSet Flags) { return Flags ^ FlagSet; }, EStatusChangeCause::Toggle);
 }
 
 void UStatusComponent::ModifyStatusFlags(int32 FlagsToAdd, int32 FlagsToRemove)
 {
-   const uint8 OldFlags = StatusFlags;
-   StatusFlags = (OldFlags | static_cast<uint8>(FlagsToAdd)) & ~static_cast<uint8>(FlagsToRemove);
-
-   if (FlagsToAdd && ((OldFlags | static_cast<uint8>(FlagsToAdd)) != OldFlags)) 
-   {
-       OnStatusFlagAdded.Broadcast(static_cast<EStatusFlags>(FlagsToAdd));
-   }
-   
-   if (FlagsToRemove && ((OldFlags & ~static_cast<uint8>(FlagsToRemove)) != OldFlags)) 
-   {
-       OnStatusFlagRemoved.Broadcast(static_cast<EStatusFlags>(FlagsToRemove));
-   }
+   const FStatusCoreFlagSet AddSet = ToCoreFlagSet(FlagsToAdd);
+   const FStatusCoreFlagSet RemoveSet = ToCoreFlagSet(FlagsToRemove);
+   UpdateStatusFlags([AddSet, RemoveSet](FStatusCoreFlagSet Flags) { return (Flags | AddSet) & ~RemoveSet; }, EStatusChangeCause::Modify);
 }
 
 void UStatusComponent::ClearAllStatusFlags()
 {
-   if (StatusFlags == 0) return;
-   
-   const uint8 OldFlags = StatusFlags;
-   StatusFlags = 0;
-   OnStatusFlagRemoved.Broadcast(static_cast<EStatusFlags>(OldFlags));
+   UpdateStatusFlags([](FStatusCoreFlagSet) { return FStatusCoreFlagSet(); }, EStatusChangeCause::ClearAll);
 }
 
 // Flag checks
 bool UStatusComponent::HasAllFlags(int32 FlagsToCheck) const
 {
-   if (FlagsToCheck == 0) return true;
-   return (StatusFlags & static_cast<uint8>(FlagsToCheck)) == static_cast<uint8>(FlagsToCheck);
+   FStatusTrace::CountQuery();
+   return GetCoreStatusFlags().HasAll(ToCoreFlagSet(FlagsToCheck));
 }
 
 bool UStatusComponent::HasAnyFlags(int32 FlagsToCheck) const
 {
-   if (FlagsToCheck == 0) return false;
-   return (StatusFlags & static_cast<uint8>(FlagsToCheck)) != 0;
+   FStatusTrace::CountQuery();
+   return GetCoreStatusFlags().HasAny(ToCoreFlagSet(FlagsToCheck));
 }
 
 bool UStatusComponent::HasStatusFlag(EStatusFlags Flag) const
 {
-   return (StatusFlags & static_cast<uint8>(Flag)) != 0;
+   FStatusTrace::CountQuery();
+   return GetCoreStatusFlags().HasAny(ToCoreFlagSet(static_cast<int32>(Flag)));
 }
 
 bool UStatusComponent::HasAnyStatusFlags(EStatusFlags Flags) const
 {
-   return (StatusFlags & static_cast<uint8>(Flags)) != 0;
+   FStatusTrace::CountQuery();
+   return GetCoreStatusFlags().HasAny(ToCoreFlagSet(static_cast<int32>(Flags)));
 }
 
 bool UStatusComponent::HasAllStatusFlags(EStatusFlags Flags) const
 {
-   return (StatusFlags & static_cast<uint8>(Flags)) == static_cast<uint8>(Flags);
+   FStatusTrace::CountQuery();
+   return GetCoreStatusFlags().HasAll(ToCoreFlagSet(static_cast<int32>(Flags)));
 }
 
 // Action validation
 bool UStatusComponent::CanPerformAction(int32 MustHaveFlags, int32 MustNotHaveFlags) const
 {
-   // Check if all required flags are present
-   if ((StatusFlags & static_cast<uint8>(MustHaveFlags)) != static_cast<uint8>(MustHaveFlags))
+   FStatusTrace::CountQuery();
+
+   // All required flags must be present and none of the prohibited ones
+   return GetCoreStatusFlags().CanPerformAction(ToCoreFlagSet(MustHaveFlags), ToCoreFlagSet(MustNotHaveFlags));
+}
+
+// Action rules
+bool UStatusComponent::IsActionAllowed(FName ActionName) const
+{
+   FStatusTrace::CountQuery();
+   if (!ActionRules) return false;
+
+   return GetAllowedActions().IsAllowed(ActionRules->FindActionIndex(ActionName));
+}
+
+const FStatusAllowedActions& UStatusComponent::GetAllowedActions() const
+{
+   if (!ActionRules)
+   {
+       CachedAllowedActions.Words.Reset();
+       CachedActionRules.Reset();
+       return CachedAllowedActions;
+   }
+
+   const bool bCacheValid = CachedActionRules.Get() == ActionRules
+       && CachedActionRulesVersion == ActionRules->GetCompiledVersion()
+       && CachedActionFlags == StatusFlags;
+   if (!bCacheValid)
+   {
+       ActionRules->EvaluateAll(StatusFlags, CachedAllowedActions);
+       CachedActionRules = ActionRules;
+       CachedActionRulesVersion = ActionRules->GetCompiledVersion();
+       CachedActionFlags = StatusFlags;
+   }
+   return CachedAllowedActions;
+}
+
+// Extended flag operations
+void UStatusComponent::AddExtendedStatusFlags(const FStatusExtendedFlagSet& FlagsToAdd)
+{
+   ModifyExtendedStatusFlags(FlagsToAdd, FStatusExtendedFlagSet());
+}
+
+void UStatusComponent::RemoveExtendedStatusFlags(const FStatusExtendedFlagSet& FlagsToRemove)
+{
+   ModifyExtendedStatusFlags(FStatusExtendedFlagSet(), FlagsToRemove);
+}
+
+void UStatusComponent::ToggleExtendedStatusFlags(const FStatusExtendedFlagSet& FlagsToToggle)
+{
+   const FStatusExtendedFlagSet OldFlags = ExtendedStatusFlags;
+   ExtendedStatusFlags ^= FlagsToToggle;
+
+   if (ExtendedStatusFlags != OldFlags)
    {
-       return false;
+       OnExtendedStatusFlagsChanged.Broadcast(OldFlags, ExtendedStatusFlags);
    }
-   
-   // Check if none of the prohibited flags are present
-   if ((StatusFlags & static_cast<uint8>(MustNotHaveFlags)) != 0)
+}
+
+void UStatusComponent::ModifyExtendedStatusFlags(const FStatusExtendedFlagSet& FlagsToAdd, const FStatusExtendedFlagSet& FlagsToRemove)
+{
+   const FStatusExtendedFlagSet OldFlags = ExtendedStatusFlags;
+   ExtendedStatusFlags = (OldFlags | FlagsToAdd) & ~FlagsToRemove;
+
+   if (ExtendedStatusFlags != OldFlags)
    {
-       return false;
+       OnExtendedStatusFlagsChanged.Broadcast(OldFlags, ExtendedStatusFlags);
    }
-   
-   return true;
+}
+
+bool UStatusComponent::CanPerformExtendedAction(const FStatusExtendedFlagSet& MustHaveFlags, const FStatusExtendedFlagSet& MustNotHaveFlags) const
+{
+   return ExtendedStatusFlags.CanPerformAction(MustHaveFlags, MustNotHaveFlags);
 }
 
 // Utility functions
-void UStatusComponent::AddTimedStatusFlag(EStatusFlags Flag, float Duration)
+void UStatusComponent::AddTimedStatusFlag(EStatusFlags Flag, float Duration, EStatusTimedFlagPolicy Policy)
 {
    if (!IsValidFlag(Flag) || Duration <= 0.0f) return;
 
+   // Expirations are driven by the world status store, which the component joins on BeginPlay.
+   // Until then the expiry waits in a queue, the flag itself is set right away.
+   if (StatusStore && StatusStoreIndex != INDEX_NONE)
+   {
+       ScheduleStatusFlagExpiry(Flag, Duration, Policy);
+   }
+   else
+   {
+       PendingTimedFlags.Add({ Flag, Duration, Policy });
+   }
    AddStatusFlag(Flag);
-   FTimerHandle TimerHandle;
-   GetWorld()->GetTimerManager().SetTimer(TimerHandle, [this, Flag]()
+}
+
+void UStatusComponent::ScheduleStatusFlagExpiry(EStatusFlags Flag, float Duration, EStatusTimedFlagPolicy Policy)
+{
+   FStatusExpiryScheduler& Scheduler = StatusStore->GetExpiryScheduler();
+   const int32 BitIndex = FMath::CountTrailingZeros(static_cast<uint32>(Flag));
+   const double CurrentExpireTime = Scheduler.GetExpireTime(StatusStoreIndex, BitIndex);
+   double ExpireTime = GetWorld()->GetTimeSeconds() + Duration;
+
+   if (CurrentExpireTime > 0.0)
    {
-       ClearStatusFlag(Flag);
-   }, Duration, false);
+       switch (Policy)
+       {
+       case EStatusTimedFlagPolicy::KeepLongest:
+           ExpireTime = FMath::Max(CurrentExpireTime, ExpireTime);
+           break;
+       case EStatusTimedFlagPolicy::Extend:
+           ExpireTime = CurrentExpireTime + Duration;
+           break;
+       default:
+           break;
+       }
+   }
+
+   Scheduler.Schedule(StatusStoreIndex, BitIndex, ExpireTime);
+   MarkStatusReplicationDirty();
+}
+
+void UStatusComponent::CancelTimedStatusFlag(EStatusFlags Flag)
+{
+   if (!IsValidFlag(Flag) || !StatusStore || StatusStoreIndex == INDEX_NONE) return;
+
+   StatusStore->GetExpiryScheduler().Cancel(StatusStoreIndex, static_cast<uint8>(Flag));
+   MarkStatusReplicationDirty();
+}
+
+float UStatusComponent::GetTimedStatusFlagRemainingTime(EStatusFlags Flag) const
+{
+   if (!IsValidFlag(Flag) || !StatusStore || StatusStoreIndex == INDEX_NONE) return 0.0f;
+
+   const int32 BitIndex = FMath::CountTrailingZeros(static_cast<uint32>(Flag));
+   const double ExpireTime = StatusStore->GetExpiryScheduler().GetExpireTime(StatusStoreIndex, BitIndex);
+   if (ExpireTime <= 0.0) return 0.0f;
+
+   return static_cast<float>(FMath::Max(ExpireTime - GetWorld()->GetTimeSeconds(), 0.0));
+}
+
+void UStatusComponent::GetReplicatedState(FStatusReplicatedState& OutState) const
+{
+   OutState.Flags = StatusFlags;
+   OutState.TimedMask = 0;
+   if (!StatusStore || StatusStoreIndex == INDEX_NONE) return;
+
+   const FStatusExpiryScheduler& Scheduler = StatusStore->GetExpiryScheduler();
+   const double Now = GetWorld()->GetTimeSeconds();
+   OutState.TimedMask = Scheduler.GetTimedMask(StatusStoreIndex) & StatusFlags;
+   for (uint32 Bits = OutState.TimedMask; Bits; Bits &= Bits - 1)
+   {
+       const int32 BitIndex = FMath::CountTrailingZeros(Bits);
+       OutState.SetRemainingTime(BitIndex, static_cast<float>(Scheduler.GetExpireTime(StatusStoreIndex, BitIndex) - Now));
+   }
+}
+
+void UStatusComponent::ApplyReplicatedState(const FStatusReplicatedState& State)
+{
+   const FStatusCoreFlagSet ReplicatedFlags = FStatusCoreFlagSet::FromBits(State.Flags);
+   UpdateStatusFlags([ReplicatedFlags](FStatusCoreFlagSet) { return ReplicatedFlags; }, EStatusChangeCause::Replicated);
+   if (!StatusStore || StatusStoreIndex == INDEX_NONE) return;
+
+   // Mirror the server's expirations so timed flags run out locally at the same time
+   FStatusExpiryScheduler& Scheduler = StatusStore->GetExpiryScheduler();
+   const double Now = GetWorld()->GetTimeSeconds();
+   Scheduler.Cancel(StatusStoreIndex, ~State.TimedMask);
+   for (uint32 Bits = State.TimedMask & State.Flags; Bits; Bits &= Bits - 1)
+   {
+       const int32 BitIndex = FMath::CountTrailingZeros(Bits);
+       Scheduler.Schedule(StatusStoreIndex, BitIndex, Now + State.GetRemainingTime(BitIndex));
+   }
+}
+
+void UStatusComponent::RestoreStatusState(uint8 Flags, uint8 TimedMask, TConstArrayView<float> RemainingTimes)
+{
+   const FStatusCoreFlagSet RestoredFlags = FStatusCoreFlagSet::FromBits(Flags);
+   UpdateStatusFlags([RestoredFlags](FStatusCoreFlagSet) { return RestoredFlags; }, EStatusChangeCause::Restored);
+   if (!StatusStore || StatusStoreIndex == INDEX_NONE) return;
+
+   FStatusExpiryScheduler& Scheduler = StatusStore->GetExpiryScheduler();
+   const double Now = GetWorld()->GetTimeSeconds();
+   Scheduler.Cancel(StatusStoreIndex, ~TimedMask);
+   int32 TimeIndex = 0;
+   for (uint32 Bits = TimedMask; Bits && TimeIndex < RemainingTimes.Num(); Bits &= Bits - 1, ++TimeIndex)
+   {
+       const int32 BitIndex = FMath::CountTrailingZeros(Bits);
+       if (Flags & (1 << BitIndex))
+       {
+           Scheduler.Schedule(StatusStoreIndex, BitIndex, Now + RemainingTimes[TimeIndex]);
+       }
+   }
+   MarkStatusReplicationDirty();
 }
 
 FString UStatusComponent::GetActiveFlagsAsString() const
 {
-   FString Result;
-   for (int32 i = 0; i < 8; ++i)
+   return GetActiveFlagsDisplayString();
+}
+
+const FString& UStatusComponent::GetActiveFlagsDisplayString() const
+{
+   return FStatusDisplayStrings::GetString(GetCoreStatusFlags().GetWord(0));
+}
+
+void UStatusComponent::ExpireStatusFlags(uint8 ExpiredFlags)
+{
+   const FStatusCoreFlagSet ExpiredSet = FStatusCoreFlagSet::FromBits(ExpiredFlags);
+   UpdateStatusFlags([ExpiredSet](FStatusCoreFlagSet Flags) { return Flags & ~ExpiredSet; }, EStatusChangeCause::Expired);
+}
+
+void UStatusComponent::CommitStatusFlags(uint8 NewFlags, EStatusChangeCause Cause)
+{
+   const uint8 OldFlags = StatusFlags;
+   if (NewFlags == OldFlags) return;
+
+   SetStatusFlagsInternal(NewFlags);
+
+   if (FStatusJournal::IsRecording())
+   {
+       FStatusJournal::Record(StatusComponentId, OldFlags, NewFlags, Cause);
+   }
+   FStatusTrace::TraceTransition(StatusComponentId, OldFlags, NewFlags, Cause);
+
+   // A store event batch holds the events back like deferred mode, and flushes them when it ends
+   if (!bDeferStatusEvents && !(StatusStore && StatusStore->IsBatchingEvents()))
+   {
+       BroadcastStatusChange(OldFlags, NewFlags);
+       return;
+   }
+
+   // Remember the flags of the first change, the tick sends the net difference
+   if (!bHasPendingStatusEvents)
+   {
+       bHasPendingStatusEvents = true;
+       PendingEventBaseFlags = OldFlags;
+       SetComponentTickEnabled(true);
+   }
+}
+
+void UStatusComponent::BroadcastStatusChange(uint8 OldFlags, uint8 NewFlags)
+{
+   const FStatusFlagsDiff Diff(OldFlags, NewFlags);
+
+   if (Diff.AddedFlags) OnStatusFlagAdded.Broadcast(static_cast<EStatusFlags>(Diff.AddedFlags));
+   if (Diff.RemovedFlags) OnStatusFlagRemoved.Broadcast(static_cast<EStatusFlags>(Diff.RemovedFlags));
+
+   OnStatusFlagsChanged.Broadcast(Diff);
+   if (StatusFlagsChangedChannel)
+   {
+       StatusFlagsChangedChannel->Broadcast(this, Diff);
+   }
+   OnStatusFlagsChangedNative.Broadcast(this, Diff);
+}
+
+void UStatusComponent::SetStatusFlagsInternal(uint8 NewFlags)
+{
+   const uint8 RemovedFlags = StatusFlags & ~NewFlags;
+   StatusFlags = NewFlags;
+   MarkStatusReplicationDirty();
+   if (StatusStore && StatusStoreIndex != INDEX_NONE)
    {
-       const EStatusFlags Flag = static_cast<EStatusFlags>(1 << i);
-       if (HasStatusFlag(Flag))
+       StatusStore->SetStoredFlags(StatusStoreIndex, NewFlags);
+
+       // A cleared flag must not be removed again later by a stale expiry
+       if (RemovedFlags)
        {
-           if (!Result.IsEmpty()) Result += TEXT(", ");
-           Result += UEnum::GetDisplayValueAsText(Flag).ToString();
+           StatusStore->GetExpiryScheduler().Cancel(StatusStoreIndex, RemovedFlags);
        }
    }
-   return Result.IsEmpty() ? TEXT("None") : Result;
+}
+
+void UStatusComponent::MarkStatusReplicationDirty()
+{
+   if (StatusStore && StatusReplicationIndex != INDEX_NONE)
+   {
+       StatusStore->MarkReplicationDirty(this);
+   }
 }
 
 bool UStatusComponent::IsValidFlag(EStatusFlags Flag) const
@@ -204,4 +570,53 @@ bool UStatusComponent::IsValidFlag(EStatusFlags Flag) const
    // A valid single-bit flag has exactly one bit set to 1
    // We can check this using the formula (n & (n-1)) == 0
    return FlagValue != 0 && (FlagValue & (FlagValue - 1)) == 0;
-}
\ No newline at end of file
+}
+
+// Stress test
+bool UStatusComponent::RunAtomicStressTest(int32 NumThreads, int32 TogglesPerThread)
+{
+   // A transient component has no world, so initializing it only sets up the atomic word
+   UStatusComponent* Component = NewObject<UStatusComponent>(GetTransientPackage());
+   Component->bAtomicStatusFlags = true;
+   Component->InitializeStatusComponent();
+
+   int32 NumBroadcasts = 0;
+   uint8 LastFlags = 0;
+   bool bOrdered = true;
+   const FDelegateHandle Handle = Component->OnStatusFlagsChangedNative.AddLambda([&](UStatusComponent*, const FStatusFlagsDiff& Diff)
+   {
+       bOrdered &= Diff.OldFlags == LastFlags;
+       LastFlags = Diff.NewFlags;
+       ++NumBroadcasts;
+   });
+
+   // Every toggle changes the flags, so every call is one transition
+   ParallelFor(NumThreads, [Component, TogglesPerThread](int32 ThreadIndex)
+   {
+       const int32 Flag = 1 << (ThreadIndex % 8);
+       for (int32 Iteration = 0; Iteration < TogglesPerThread; ++Iteration)
+       {
+           Component->ToggleStatusFlags(Flag);
+       }
+   }, EParallelForFlags::Unbalanced);
+
+   Component->DrainAtomicTransitions();
+   Component->OnStatusFlagsChangedNative.Remove(Handle);
+
+   const int32 Expected = NumThreads * TogglesPerThread;
+   const bool bPassed = NumBroadcasts == Expected && bOrdered && LastFlags == Component->StatusFlags
+       && Component->GetCoreStatusFlags().GetWord(0) == Component->StatusFlags;
+   UE_LOG(LogTemp, Display, TEXT("Status atomic stress test %s: %d/%d transitions delivered, order %s, final flags %d"),
+       bPassed ? TEXT("passed") : TEXT("FAILED"), NumBroadcasts, Expected, bOrdered ? TEXT("kept") : TEXT("broken"), Component->StatusFlags);
+   return bPassed;
+}
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand StatusAtomicStressTestCommand(
+   TEXT("Status.Atomic.StressTest"),
+   TEXT("Toggles flags of one atomic status component from many threads. Arguments: [NumThreads] [TogglesPerThread]"),
+   FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+   {
+       UStatusComponent::RunAtomicStressTest(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 8, Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 10000);
+   }));
+#endif
\ No newline at end of file
@@ -2,6 +2,11 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "StatusFlagSet.h"
+#include "StatusActionRuleSet.h"
+#include "StatusTransitionRuleSet.h"
+#include "Containers/Queue.h"
+#include <atomic>
 #include "StatusComponent.generated.h"
 
 /**
@@ -21,16 +26,89 @@ enum class EStatusFlags : uint8
   IsBreathing  = 1 << 6  UMETA(DisplayName = "Breathing"),
   IsSneaking   = 1 << 7  UMETA(DisplayName = "Sneaking")
 // Since this Enum is an 8 bit uint8, maximum 8 flags can be defined
-// If more flags are needed, the data type should be changed to uint16 or uint32
+// Additional game-defined states live in the extended flag set (see FStatusExtendedFlagSet)
 };
 ENUM_CLASS_FLAGS(EStatusFlags);
 
+/**
+ * How AddTimedStatusFlag treats a flag that already has a pending expiry
+ */
+UENUM(BlueprintType)
+enum class EStatusTimedFlagPolicy : uint8
+{
+  Refresh      UMETA(DisplayName = "Refresh", ToolTip = "Restart the duration from now"),
+  KeepLongest  UMETA(DisplayName = "Keep Longest", ToolTip = "Keep whichever expiry is later"),
+  Extend       UMETA(DisplayName = "Extend", ToolTip = "Add the duration to the remaining time")
+};
+
+/**
+ * Operation that caused a status change, recorded by the status journal
+ */
+UENUM(BlueprintType)
+enum class EStatusChangeCause : uint8
+{
+  Add,
+  Remove,
+  Toggle,
+  Modify,
+  ClearAll,
+  Expired,
+  Replicated,
+  Restored
+};
+
+/**
+ * Net change of the status flags, either of a single mutation or of a whole frame in deferred mode
+ */
+USTRUCT(BlueprintType)
+struct FStatusFlagsDiff
+{
+  GENERATED_BODY()
+
+  FStatusFlagsDiff() = default;
+  FStatusFlagsDiff(uint8 InOldFlags, uint8 InNewFlags)
+      : OldFlags(InOldFlags)
+      , NewFlags(InNewFlags)
+      , AddedFlags(InNewFlags & ~InOldFlags)
+      , RemovedFlags(InOldFlags & ~InNewFlags)
+  {
+  }
+
+  /** Flags before the change */
+  UPROPERTY(BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 OldFlags = 0;
+
+  /** Flags after the change */
+  UPROPERTY(BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 NewFlags = 0;
+
+  /** Flags that were not set before and are set now */
+  UPROPERTY(BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 AddedFlags = 0;
+
+  /** Flags that were set before and are not set now */
+  UPROPERTY(BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 RemovedFlags = 0;
+};
+
 // Delegate triggered when the component is initialized
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnStatusComponentInitialized);
 
 // Delegates triggered when status flags change
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStatusFlagChanged, EStatusFlags, Flag);
 
+// Delegate triggered once per change (or once per frame in deferred mode) with the net difference
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStatusFlagsChanged, const FStatusFlagsDiff&, Diff);
+
+// Native counterpart of FOnStatusFlagsChanged for C++ listeners
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnStatusFlagsChangedNative, class UStatusComponent*, const FStatusFlagsDiff&);
+
+// Proxy based channel for hot C++ listeners, defined in StatusFlagsChangedChannel.h
+class FStatusFlagsChangedChannel;
+
+// Native delegate triggered when the extended flags change (old flags, new flags)
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnExtendedStatusFlagsChanged, const FStatusExtendedFlagSet&, const FStatusExtendedFlagSet&);
+
 /**
  * StatusComponent - Component that manages the character's current state using bitflags
  * This component is used to track various states of the character (performing action, hiding, injured, etc.)
@@ -43,21 +121,78 @@ class GAME_API UStatusComponent : public UActorComponent
 
 public:
   UStatusComponent();
+  virtual ~UStatusComponent() override;
 
   /** Triggered when the component is successfully initialized */
   UPROPERTY(BlueprintAssignable)
   FOnStatusComponentInitialized OnStatusComponentInitialized;
 
-  /** Triggered when a status flag is added */
+  /** Triggered when status flags are added, the parameter holds every flag that was added */
   UPROPERTY(BlueprintAssignable, Category = "Status")
   FOnStatusFlagChanged OnStatusFlagAdded;
   
-  /** Triggered when a status flag is removed */
+  /** Triggered when status flags are removed, the parameter holds every flag that was removed */
   UPROPERTY(BlueprintAssignable, Category = "Status")  
   FOnStatusFlagChanged OnStatusFlagRemoved;
 
+  /** Triggered with the net difference of every change, after OnStatusFlagAdded/OnStatusFlagRemoved */
+  UPROPERTY(BlueprintAssignable, Category = "Status")
+  FOnStatusFlagsChanged OnStatusFlagsChanged;
+
+  /** Native version of OnStatusFlagsChanged, avoids the reflection cost of dynamic delegates */
+  FOnStatusFlagsChangedNative OnStatusFlagsChangedNative;
+
+  /**
+   * Fast path of OnStatusFlagsChangedNative, sent just before it. Listeners are small callables stored inline in one
+   * contiguous array, so systems that listen to many components pay one indirect call per change.
+   * Created on first use, include StatusFlagsChangedChannel.h to add listeners.
+   */
+  FStatusFlagsChangedChannel& GetStatusFlagsChangedChannel();
+
+  /** Id of this component in the status journal and trace, unique for the lifetime of the process and never reused */
+  FORCEINLINE uint32 GetStatusComponentId() const { return StatusComponentId; }
+
+  /**
+   * If true, changes are gathered during the frame and the events above are sent once
+   * with the net difference at StatusEventTickGroup. Changes that cancel each other send nothing.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status|Events")
+  bool bDeferStatusEvents = false;
+
+  /** Tick group in which deferred status events are sent */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status|Events", meta = (EditCondition = "bDeferStatusEvents"))
+  TEnumAsByte<ETickingGroup> StatusEventTickGroup = TG_PostUpdateWork;
+
+  /**
+   * If true and the owner replicates, the server replicates the flags and timed flag durations
+   * to every player the owner is relevant to, through the players' status replication managers. The component must be net addressable
+   * (a default subobject or a replicated component).
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status|Replication")
+  bool bReplicateStatusFlags = true;
+
+  /**
+   * Id used by status snapshots, required for actors spawned at runtime (their names depend on the spawn order)
+   * Set it when spawning a saved actor, or leave it invalid for actors placed in a level
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame, Category = "Status|Snapshot")
+  FGuid PersistentId;
+
+  /**
+   * If true, the flags are kept in an atomic word so they can be read and changed from any thread
+   * (animation worker threads, async AI tasks). Reads are wait-free and changes use compare-and-swap.
+   * Changes made on other threads reach StatusFlags, the store and the events on the game thread, in the order they happened.
+   * Timed flags, extended flags and action rules stay game thread only. Must be set before BeginPlay.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status|Threading")
+  bool bAtomicStatusFlags = false;
+
+  /** Triggered when the extended flags change, native only */
+  FOnExtendedStatusFlagsChanged OnExtendedStatusFlagsChanged;
+
 protected:
   virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
   
   /** Initializes the component and establishes necessary connections */
   void InitializeStatusComponent();
@@ -65,8 +200,12 @@ protected:
 public:
   virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
-  /** Current status flags of the character */
-  UPROPERTY(SaveGame, EditAnywhere, BlueprintReadWrite, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  /**
+   * Current status flags of the character, EditAnywhere only sets the initial flags
+   * Read only at runtime: change them through the functions below, they also keep the world status store,
+   * timed flag expiries, atomic state, replication, journal and trace in sync
+   */
+  UPROPERTY(SaveGame, EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
   uint8 StatusFlags;
 
   /**
@@ -173,13 +312,56 @@ public:
       UPARAM(meta = (Bitmask, BitmaskEnum = "EStatusFlags")) int32 MustNotHaveFlags
   ) const;
 
+  /**
+   * Checks a named action of ActionRules against the current flags
+   * The result of every action is computed in one pass and cached until the flags change
+   * @param ActionName - Name of the action in ActionRules
+   * @return True: Action can be performed, False: Action cannot be performed or is unknown
+   */
+  UFUNCTION(BlueprintPure, Category = "Status")
+  bool IsActionAllowed(FName ActionName) const;
+
+  /**
+   * Returns which actions of ActionRules can be performed with the current flags, one bit per action index
+   * Recomputed only when the flags or the rule set changed since the last call
+   */
+  const FStatusAllowedActions& GetAllowedActions() const;
+
+  /** Named actions whose status requirements are evaluated by IsActionAllowed */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status|Actions")
+  TObjectPtr<UStatusActionRuleSet> ActionRules;
+
+  /**
+   * Implication, exclusion and block rules applied to every change of the core flags
+   * A change resolves to its final flags before it is committed, so it sends one change event
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status|Rules")
+  TObjectPtr<UStatusTransitionRuleSet> TransitionRules;
+
   /**
    * Adds a status flag for a specific duration and automatically removes it after the duration expires
+   * Re-applying a timed flag updates its existing expiry instead of stacking timers
    * @param Flag - The status flag to add
    * @param Duration - Duration (in seconds) for which the flag will remain active
+   * @param Policy - How an already pending expiry of the same flag is updated
    */
   UFUNCTION(BlueprintCallable, Category = "Status")
-  void AddTimedStatusFlag(EStatusFlags Flag, float Duration);
+  void AddTimedStatusFlag(EStatusFlags Flag, float Duration, EStatusTimedFlagPolicy Policy = EStatusTimedFlagPolicy::Refresh);
+
+  /**
+   * Cancels the pending expiry of a timed flag, the flag itself stays active
+   * @param Flag - The timed status flag
+   */
+  UFUNCTION(BlueprintCallable, Category = "Status")
+  void CancelTimedStatusFlag(EStatusFlags Flag);
+
+  /**
+   * Returns the time left before a timed flag expires
+   * @param Flag - The timed status flag
+   * @return Remaining time in seconds, 0 if the flag has no pending expiry
+   */
+  UFUNCTION(BlueprintPure, Category = "Status")
+  float GetTimedStatusFlagRemainingTime(EStatusFlags Flag) const;
 
   /**
    * Returns active status flags as a readable string
@@ -188,7 +370,149 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Status")
   FString GetActiveFlagsAsString() const;
 
+  /**
+   * Returns active status flags as a readable string without building it, for per-frame debug display
+   * @return Cached comma-separated string of active flags, valid for the lifetime of the program
+   */
+  const FString& GetActiveFlagsDisplayString() const;
+
+  /**
+   * Sends the pending deferred status events right away
+   */
+  UFUNCTION(BlueprintCallable, Category = "Status")
+  void FlushStatusEvents();
+
+  /**
+   * Fills the replicated representation of the current status
+   * @param OutState - Receives the flags and quantized timed flag durations
+   */
+  void GetReplicatedState(struct FStatusReplicatedState& OutState) const;
+
+  /**
+   * Applies a status received from the server, timed flags are scheduled to expire locally as well
+   * @param State - Replicated status
+   */
+  void ApplyReplicatedState(const struct FStatusReplicatedState& State);
+
+  /**
+   * Applies a saved status, the transition rules are skipped since the saved flags were already resolved
+   * @param Flags - Saved flags
+   * @param TimedMask - Saved flags that expire
+   * @param RemainingTimes - Seconds left for each bit of TimedMask, in bit order
+   */
+  void RestoreStatusState(uint8 Flags, uint8 TimedMask, TConstArrayView<float> RemainingTimes);
+
+  /** Core flags as a flag set, safe to call from any thread in atomic mode */
+  FORCEINLINE FStatusCoreFlagSet GetCoreStatusFlags() const
+  {
+    return FStatusCoreFlagSet::FromBits(bAtomicStateReady ? static_cast<uint8>(AtomicState.load(std::memory_order_acquire)) : StatusFlags);
+  }
+
+  /** Game-defined flags beyond the 8 core flags, indexed by the game's own enum */
+  FORCEINLINE const FStatusExtendedFlagSet& GetExtendedStatusFlags() const { return ExtendedStatusFlags; }
+
+  /** True if the given extended flag is set */
+  FORCEINLINE bool HasExtendedStatusFlag(int32 FlagIndex) const { return ExtendedStatusFlags.Test(FlagIndex); }
+
+  /**
+   * Adds multiple extended flags
+   * @param FlagsToAdd - Extended flags to add
+   */
+  void AddExtendedStatusFlags(const FStatusExtendedFlagSet& FlagsToAdd);
+
+  /**
+   * Removes multiple extended flags
+   * @param FlagsToRemove - Extended flags to remove
+   */
+  void RemoveExtendedStatusFlags(const FStatusExtendedFlagSet& FlagsToRemove);
+
+  /**
+   * Toggles extended flags (removes if present, adds if not)
+   * @param FlagsToToggle - Extended flags to toggle
+   */
+  void ToggleExtendedStatusFlags(const FStatusExtendedFlagSet& FlagsToToggle);
+
+  /**
+   * Simultaneously adds some extended flags and removes others
+   * @param FlagsToAdd - Extended flags to add
+   * @param FlagsToRemove - Extended flags to remove
+   */
+  void ModifyExtendedStatusFlags(const FStatusExtendedFlagSet& FlagsToAdd, const FStatusExtendedFlagSet& FlagsToRemove);
+
+  /**
+   * Checks extended status conditions required to perform an action
+   * @param MustHaveFlags - Extended flags that must be present
+   * @param MustNotHaveFlags - Extended flags that must not be present
+   * @return True: Action can be performed, False: Action cannot be performed
+   */
+  bool CanPerformExtendedAction(const FStatusExtendedFlagSet& MustHaveFlags, const FStatusExtendedFlagSet& MustNotHaveFlags) const;
+
+  /** Index of this component in the world status store, INDEX_NONE while unregistered */
+  FORCEINLINE int32 GetStatusStoreIndex() const { return StatusStoreIndex; }
+
+  /**
+   * Toggles the flags of a transient atomic component from many threads and checks every transition is delivered in order
+   * Run with the Status.Atomic.StressTest [NumThreads] [TogglesPerThread] console command
+   * @return True if the check passed
+   */
+  static bool RunAtomicStressTest(int32 NumThreads, int32 TogglesPerThread);
+
 private:
+  friend class UStatusWorldSubsystem;
+
+  /**
+   * Computes the new flags from the current ones and commits them
+   * In atomic mode the transform runs in a compare-and-swap loop and may be called several times
+   * @param Transform - Returns the new flags for the given current flags
+   * @param Cause - Operation that caused the change
+   */
+  template <typename TransformType>
+  void UpdateStatusFlags(TransformType&& Transform, EStatusChangeCause Cause);
+
+  /** Applies the transitions made in atomic mode to StatusFlags in order, game thread only */
+  void DrainAtomicTransitions();
+
+  /**
+   * Applies a new flag value, records it in the status journal and sends (or queues, in deferred mode) the change events
+   * @param NewFlags - The new value of StatusFlags
+   * @param Cause - Operation that caused the change
+   */
+  void CommitStatusFlags(uint8 NewFlags, EStatusChangeCause Cause);
+
+  /**
+   * Removes flags whose timed duration ran out, called by the world status store
+   * @param ExpiredFlags - Bitmask of expired flags
+   */
+  void ExpireStatusFlags(uint8 ExpiredFlags);
+
+  /**
+   * Schedules the expiry of a timed flag in the world status store, the component must be registered
+   * @param Flag - The timed status flag
+   * @param Duration - Seconds before the flag expires
+   * @param Policy - How an already pending expiry of the same flag is updated
+   */
+  void ScheduleStatusFlagExpiry(EStatusFlags Flag, float Duration, EStatusTimedFlagPolicy Policy);
+
+  /**
+   * Broadcasts the added/removed/changed events for a net change
+   * @param OldFlags - Flags before the change
+   * @param NewFlags - Flags after the change
+   */
+  void BroadcastStatusChange(uint8 OldFlags, uint8 NewFlags);
+
+  /**
+   * Writes the new flags and mirrors them into the world status store
+   * Cleared flags also drop their pending expiry
+   * @param NewFlags - The new value of StatusFlags
+   */
+  void SetStatusFlagsInternal(uint8 NewFlags);
+
+  /** Queues the current status for replication when this component is replicated by the server */
+  void MarkStatusReplicationDirty();
+
+  /** Converts a Blueprint bitmask into a core flag set */
+  static FORCEINLINE constexpr FStatusCoreFlagSet ToCoreFlagSet(int32 Mask) { return FStatusCoreFlagSet::FromBits(static_cast<uint8>(Mask)); }
+
   /**
    * Checks if the flag value is a valid single-bit flag
    * @param Flag - The flag to check
@@ -200,5 +524,78 @@ private:
   /** Character that owns this component */
   UPROPERTY()
   TObjectPtr<class ACharacter> OwnerCharacter;
+
+  /** World store that holds a packed copy of the flags of every status component */
+  UPROPERTY(Transient)
+  TObjectPtr<class UStatusWorldSubsystem> StatusStore;
+
+  /** See GetStatusComponentId */
+  uint32 StatusComponentId = 0;
+
+  /** Index of this component in StatusStore */
+  int32 StatusStoreIndex = INDEX_NONE;
+
+  /** Server only: index of this component in the replicated components of StatusStore */
+  int32 StatusReplicationIndex = INDEX_NONE;
+
+  /** A timed flag added before the component joined the world status store */
+  struct FPendingTimedFlag
+  {
+    EStatusFlags Flag;
+    float Duration;
+    EStatusTimedFlagPolicy Policy;
+  };
+
+  /** Expiries scheduled when the component registers with the store, in the order they were requested */
+  TArray<FPendingTimedFlag> PendingTimedFlags;
+
+  /** Listeners of GetStatusFlagsChangedChannel, null until the first one is added */
+  TUniquePtr<FStatusFlagsChangedChannel> StatusFlagsChangedChannel;
+
+  /** Flags at the time of the first change of the pending deferred events */
+  uint8 PendingEventBaseFlags = 0;
+
+  /** True while deferred events wait for the next tick */
+  bool bHasPendingStatusEvents = false;
+
+  /** A transition made in atomic mode, waiting to be applied on the game thread */
+  struct FAtomicTransition
+  {
+    uint32 Version;
+    uint8 NewFlags;
+    EStatusChangeCause Cause;
+  };
+
+  /** Atomic mode: flags in the low byte, transition counter in the upper 24 bits */
+  std::atomic<uint32> AtomicState{ 0 };
+
+  /** Atomic mode: transitions waiting for the game thread */
+  TQueue<FAtomicTransition, EQueueMode::Mpsc> AtomicTransitionQueue;
+
+  /** Atomic mode: dequeued transitions that arrived before an earlier version */
+  TArray<FAtomicTransition> PendingAtomicTransitions;
+
+  /** Atomic mode: version of the next transition to apply */
+  uint32 NextAtomicVersion = 1;
+
+  /** Atomic mode: a game thread drain is already queued */
+  std::atomic<bool> bAtomicDrainScheduled{ false };
+
+  /** True once the atomic word is initialized, reads and writes go through it from then on */
+  bool bAtomicStateReady = false;
+
+  /** Guards against draining from inside a listener */
+  bool bDrainingAtomicTransitions = false;
+
+  /** Cached result of GetAllowedActions */
+  mutable FStatusAllowedActions CachedAllowedActions;
+
+  /** Flags and rule set version the cached actions were computed for */
+  mutable uint8 CachedActionFlags = 0;
+  mutable uint32 CachedActionRulesVersion = 0;
+  mutable TWeakObjectPtr<const UStatusActionRuleSet> CachedActionRules;
+
+  /** Game-defined flags beyond the core flags, not exposed to reflection */
+  FStatusExtendedFlagSet ExtendedStatusFlags;
   
 };
\ No newline at end of file
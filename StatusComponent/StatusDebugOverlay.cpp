@@ -0,0 +1,104 @@
+#include "StatusDebugOverlay.h"
+#include "StatusComponent.h"
+#include "StatusWorldSubsystem.h"
+#include "CanvasItem.h"
+#include "Engine/Canvas.h"
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+
+namespace StatusDebugOverlay
+{
+   static bool bEnabled = false;
+   static FAutoConsoleVariableRef CVarEnabled(
+       TEXT("Status.Debug.Overlay"),
+       bEnabled,
+       TEXT("Draws the status flags of every character above its head."));
+
+   static float MaxDistance = 3000.0f;
+   static FAutoConsoleVariableRef CVarMaxDistance(
+       TEXT("Status.Debug.OverlayDistance"),
+       MaxDistance,
+       TEXT("Maximum distance of the characters drawn by Status.Debug.Overlay."));
+
+   /** Height of the text above the actor location */
+   static constexpr float HeightOffset = 100.0f;
+
+   struct FDisplayTable
+   {
+       FString Strings[256];
+       FText Texts[256];
+
+       FDisplayTable()
+       {
+           for (int32 Flags = 0; Flags < 256; ++Flags)
+           {
+               FString& String = Strings[Flags];
+               FStatusCoreFlagSet::FromBits(static_cast<uint8>(Flags)).ForEachSetFlag([&String](int32 FlagIndex)
+               {
+                   if (!String.IsEmpty()) String += TEXT(", ");
+                   String += UEnum::GetDisplayValueAsText(static_cast<EStatusFlags>(1 << FlagIndex)).ToString();
+               });
+               if (String.IsEmpty())
+               {
+                   String = TEXT("None");
+               }
+               Texts[Flags] = FText::FromString(String);
+           }
+       }
+   };
+
+   static const FDisplayTable& GetDisplayTable()
+   {
+       static const FDisplayTable Table;
+       return Table;
+   }
+}
+
+// Display strings
+const FString& FStatusDisplayStrings::GetString(uint8 Flags)
+{
+   return StatusDebugOverlay::GetDisplayTable().Strings[Flags];
+}
+
+const FText& FStatusDisplayStrings::GetText(uint8 Flags)
+{
+   return StatusDebugOverlay::GetDisplayTable().Texts[Flags];
+}
+
+// Overlay
+void FStatusDebugOverlay::Draw(const UStatusWorldSubsystem& StatusStore, UCanvas* Canvas, APlayerController* PlayerController)
+{
+   using namespace StatusDebugOverlay;
+
+   // The debug draw service calls every world, only the player's own world is drawn
+   if (!bEnabled || !Canvas || !PlayerController || PlayerController->GetWorld() != StatusStore.GetWorld()) return;
+
+   FVector ViewLocation;
+   FRotator ViewRotation;
+   PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+   const FVector ViewDirection = ViewRotation.Vector();
+   const double MaxDistanceSq = FMath::Square(static_cast<double>(MaxDistance));
+
+   FCanvasTextItem TextItem(FVector2D::ZeroVector, FText::GetEmpty(), GEngine->GetSmallFont(), FLinearColor::White);
+   TextItem.EnableShadow(FLinearColor::Black);
+   TextItem.bCentreX = true;
+
+   const TConstArrayView<uint8> PackedFlags = StatusStore.GetPackedFlags();
+   for (int32 StoreIndex = 0; StoreIndex < PackedFlags.Num(); ++StoreIndex)
+   {
+       const UStatusComponent* Component = StatusStore.GetComponentAt(StoreIndex);
+       const AActor* Owner = Component ? Component->GetOwner() : nullptr;
+       if (!Owner) continue;
+
+       const FVector Location = Owner->GetActorLocation() + FVector(0.0, 0.0, HeightOffset);
+       const FVector ToLocation = Location - ViewLocation;
+       if (ToLocation.SizeSquared() > MaxDistanceSq || (ToLocation | ViewDirection) <= 0.0) continue;
+
+       const uint8 Flags = PackedFlags[StoreIndex];
+       const FVector ScreenLocation = Canvas->Project(Location);
+       TextItem.Position = FVector2D(ScreenLocation.X, ScreenLocation.Y);
+       TextItem.Text = FStatusDisplayStrings::GetText(Flags);
+       TextItem.SetColor(EnumHasAnyFlags(static_cast<EStatusFlags>(Flags), EStatusFlags::IsDead) ? FLinearColor::Red : FLinearColor::White);
+       Canvas->DrawItem(TextItem);
+   }
+}
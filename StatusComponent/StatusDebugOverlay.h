@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCanvas;
+class APlayerController;
+class UStatusWorldSubsystem;
+
+/**
+ * StatusDisplayStrings - Display text of every combination of the core flags
+ * The 256 strings are built once from the EStatusFlags display names, lookups never allocate.
+ */
+struct GAME_API FStatusDisplayStrings
+{
+  /**
+   * Returns the comma-separated display names of a flag mask
+   * @param Flags - Core status flags
+   * @return "Injured, Dead"-like string, "None" when no flag is set
+   */
+  static const FString& GetString(uint8 Flags);
+
+  /** Same as GetString, as a text for canvas and UMG */
+  static const FText& GetText(uint8 Flags);
+};
+
+/**
+ * StatusDebugOverlay - Draws the flags of every status component of a world above its owner
+ * All components are drawn in one pass over the status store from a single debug draw callback,
+ * culled by distance and view direction, with the cached display texts.
+ * Enabled with Status.Debug.Overlay 1, the range is set by Status.Debug.OverlayDistance.
+ */
+struct GAME_API FStatusDebugOverlay
+{
+  /**
+   * Draws the components of a store for one player view
+   * @param StatusStore - Store of the world to draw
+   * @param Canvas - Canvas of the debug draw service
+   * @param PlayerController - Player whose view is drawn
+   */
+  static void Draw(const UStatusWorldSubsystem& StatusStore, UCanvas* Canvas, APlayerController* PlayerController);
+};
@@ -0,0 +1,121 @@
+#include "StatusExpiryScheduler.h"
+
+void FStatusExpiryScheduler::AddRow()
+{
+   ExpireTimes.AddZeroed(FlagsPerRow);
+}
+
+void FStatusExpiryScheduler::RemoveRowAtSwap(int32 Row)
+{
+   Cancel(Row, 0xFF);
+
+   const int32 LastRow = ExpireTimes.Num() / FlagsPerRow - 1;
+   if (Row != LastRow)
+   {
+       // Heap entries point at the old row, so the moved expirations are pushed again under their new row
+       for (int32 BitIndex = 0; BitIndex < FlagsPerRow; ++BitIndex)
+       {
+           const double ExpireTime = ExpireTimes[LastRow * FlagsPerRow + BitIndex];
+           ExpireTimes[Row * FlagsPerRow + BitIndex] = ExpireTime;
+           if (ExpireTime > 0.0)
+           {
+               Heap.HeapPush(FEntry{ ExpireTime, Row, BitIndex });
+           }
+       }
+   }
+   ExpireTimes.RemoveAt(LastRow * FlagsPerRow, FlagsPerRow, EAllowShrinking::No);
+}
+
+void FStatusExpiryScheduler::Schedule(int32 Row, int32 BitIndex, double ExpireTime)
+{
+   double& Slot = ExpireTimes[Row * FlagsPerRow + BitIndex];
+   if (Slot == ExpireTime) return;
+   if (Slot == 0.0) ++NumActive;
+
+   // The previous heap entry (if any) becomes stale because it no longer matches the slot
+   Slot = ExpireTime;
+   Heap.HeapPush(FEntry{ ExpireTime, Row, BitIndex });
+
+   if (Heap.Num() > 64 && Heap.Num() > NumActive * 2)
+   {
+       CompactHeap();
+   }
+}
+
+void FStatusExpiryScheduler::Cancel(int32 Row, uint8 FlagMask)
+{
+   double* RowTimes = ExpireTimes.GetData() + Row * FlagsPerRow;
+   for (uint32 Bits = FlagMask; Bits; Bits &= Bits - 1)
+   {
+       double& Slot = RowTimes[FMath::CountTrailingZeros(Bits)];
+       if (Slot != 0.0)
+       {
+           Slot = 0.0;
+           --NumActive;
+       }
+   }
+}
+
+uint8 FStatusExpiryScheduler::GetTimedMask(int32 Row) const
+{
+   const double* RowTimes = ExpireTimes.GetData() + Row * FlagsPerRow;
+   uint8 Mask = 0;
+   for (int32 BitIndex = 0; BitIndex < FlagsPerRow; ++BitIndex)
+   {
+       if (RowTimes[BitIndex] != 0.0) Mask |= 1 << BitIndex;
+   }
+   return Mask;
+}
+
+void FStatusExpiryScheduler::CollectExpired(double Now, TArray<TPair<int32, uint8>>& OutExpired)
+{
+   OutExpired.Reset();
+
+   while (Heap.Num() > 0 && Heap.HeapTop().ExpireTime <= Now)
+   {
+       FEntry Entry;
+       Heap.HeapPop(Entry, EAllowShrinking::No);
+
+       // Skip entries that were refreshed, cancelled or belong to a removed row
+       const int32 SlotIndex = Entry.Row * FlagsPerRow + Entry.BitIndex;
+       if (!ExpireTimes.IsValidIndex(SlotIndex) || ExpireTimes[SlotIndex] != Entry.ExpireTime) continue;
+
+       ExpireTimes[SlotIndex] = 0.0;
+       --NumActive;
+
+       OutExpired.Emplace(Entry.Row, static_cast<uint8>(1 << Entry.BitIndex));
+   }
+
+   // Merge flags of the same row so each component is updated once
+   if (OutExpired.Num() > 1)
+   {
+       OutExpired.Sort([](const TPair<int32, uint8>& A, const TPair<int32, uint8>& B) { return A.Key < B.Key; });
+
+       int32 WriteIndex = 0;
+       for (int32 ReadIndex = 1; ReadIndex < OutExpired.Num(); ++ReadIndex)
+       {
+           if (OutExpired[ReadIndex].Key == OutExpired[WriteIndex].Key)
+           {
+               OutExpired[WriteIndex].Value |= OutExpired[ReadIndex].Value;
+           }
+           else
+           {
+               OutExpired[++WriteIndex] = OutExpired[ReadIndex];
+           }
+       }
+       OutExpired.SetNum(WriteIndex + 1, EAllowShrinking::No);
+   }
+}
+
+void FStatusExpiryScheduler::CompactHeap()
+{
+   Heap.Reset();
+   for (int32 SlotIndex = 0; SlotIndex < ExpireTimes.Num(); ++SlotIndex)
+   {
+       if (ExpireTimes[SlotIndex] != 0.0)
+       {
+           Heap.Add(FEntry{ ExpireTimes[SlotIndex], SlotIndex / FlagsPerRow, SlotIndex % FlagsPerRow });
+       }
+   }
+   Heap.Heapify();
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * StatusExpiryScheduler - Shared expiry queue for timed status flags
+ * Every registered status component owns one row of 8 expiry times (one per flag bit), indexed by its store index.
+ * A min-heap of (time, row, bit) entries orders the pending expirations. Entries are never removed from the heap directly:
+ * refreshing or cancelling a flag only rewrites its row, and heap entries whose time no longer matches the row are skipped.
+ */
+struct GAME_API FStatusExpiryScheduler
+{
+  /** Number of flag bits tracked per row */
+  static constexpr int32 FlagsPerRow = 8;
+
+  /** Appends an empty row for a newly registered component */
+  void AddRow();
+
+  /**
+   * Removes a row by moving the last row into its place, mirroring the store's swap removal
+   * @param Row - Row to remove
+   */
+  void RemoveRowAtSwap(int32 Row);
+
+  /**
+   * Sets or replaces the expiry time of a flag
+   * @param Row - Store index of the component
+   * @param BitIndex - Bit index of the flag (0-7)
+   * @param ExpireTime - World time at which the flag expires
+   */
+  void Schedule(int32 Row, int32 BitIndex, double ExpireTime);
+
+  /**
+   * Cancels the pending expirations of the given flags
+   * @param Row - Store index of the component
+   * @param FlagMask - Bitmask of flags to cancel
+   */
+  void Cancel(int32 Row, uint8 FlagMask);
+
+  /**
+   * Returns the expiry time of a flag
+   * @return World time at which the flag expires, 0 if the flag has no pending expiry
+   */
+  FORCEINLINE double GetExpireTime(int32 Row, int32 BitIndex) const
+  {
+    return ExpireTimes[Row * FlagsPerRow + BitIndex];
+  }
+
+  /** Returns the bitmask of flags of a row that have a pending expiry */
+  uint8 GetTimedMask(int32 Row) const;
+
+  /**
+   * Pops every expiration that is due and groups them per row
+   * @param Now - Current world time
+   * @param OutExpired - Receives (row, expired flag mask) pairs, one per row, sorted by row
+   */
+  void CollectExpired(double Now, TArray<TPair<int32, uint8>>& OutExpired);
+
+  /** Number of flags that currently have a pending expiry */
+  FORCEINLINE int32 NumPending() const { return NumActive; }
+
+private:
+  struct FEntry
+  {
+    double ExpireTime;
+    int32 Row;
+    int32 BitIndex;
+
+    FORCEINLINE bool operator<(const FEntry& Other) const { return ExpireTime < Other.ExpireTime; }
+  };
+
+  /** Rebuilds the heap from the rows once stale entries outnumber the live ones */
+  void CompactHeap();
+
+  /** Expiry time per (row, bit), 0 when the flag is not timed */
+  TArray<double> ExpireTimes;
+
+  /** Pending expirations ordered by time, may contain stale entries */
+  TArray<FEntry> Heap;
+
+  /** Number of non-zero entries in ExpireTimes */
+  int32 NumActive = 0;
+};
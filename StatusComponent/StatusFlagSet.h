@@ -0,0 +1,218 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <bit>
+#include <type_traits>
+
+/**
+ * TStatusFlagSet - Fixed-size set of status flags packed into machine words
+ * The storage is picked at compile time: sets of up to 64 flags use the smallest unsigned integer that fits
+ * (so TStatusFlagSet<8> is exactly one uint8, the same as EStatusFlags), larger sets use an array of uint64 words.
+ * Every operation is constexpr and loops over a compile-time number of words, so they unroll completely.
+ */
+template <int32 NumFlags>
+struct TStatusFlagSet
+{
+  static_assert(NumFlags > 0, "A status flag set needs at least one flag");
+
+  /** Word type used for storage */
+  using WordType = std::conditional_t<(NumFlags <= 8), uint8,
+                   std::conditional_t<(NumFlags <= 16), uint16,
+                   std::conditional_t<(NumFlags <= 32), uint32, uint64>>>;
+
+  static constexpr int32 BitsPerWord = sizeof(WordType) * 8;
+  static constexpr int32 NumWords = (NumFlags + BitsPerWord - 1) / BitsPerWord;
+
+  /** Valid bits of the last word, bits above NumFlags are always kept clear */
+  static constexpr WordType LastWordMask = (NumFlags % BitsPerWord) == 0
+      ? static_cast<WordType>(~WordType(0))
+      : static_cast<WordType>((WordType(1) << (NumFlags % BitsPerWord)) - 1);
+
+  constexpr TStatusFlagSet() : Words{} {}
+
+  /** Creates a set from the first (up to 64) flags packed in an integer */
+  static constexpr TStatusFlagSet FromBits(uint64 LowBits)
+  {
+    TStatusFlagSet Result;
+    for (int32 WordIndex = 0; WordIndex < NumWords && WordIndex * BitsPerWord < 64; ++WordIndex)
+    {
+      Result.Words[WordIndex] = static_cast<WordType>(LowBits >> (WordIndex * BitsPerWord));
+    }
+    Result.Words[NumWords - 1] &= LastWordMask;
+    return Result;
+  }
+
+  /** Creates a set that contains a single flag */
+  static constexpr TStatusFlagSet FromIndex(int32 FlagIndex)
+  {
+    TStatusFlagSet Result;
+    Result.Set(FlagIndex);
+    return Result;
+  }
+
+  FORCEINLINE constexpr void Set(int32 FlagIndex)
+  {
+    Words[FlagIndex / BitsPerWord] |= static_cast<WordType>(WordType(1) << (FlagIndex % BitsPerWord));
+  }
+
+  FORCEINLINE constexpr void Clear(int32 FlagIndex)
+  {
+    Words[FlagIndex / BitsPerWord] &= static_cast<WordType>(~(WordType(1) << (FlagIndex % BitsPerWord)));
+  }
+
+  FORCEINLINE constexpr void Toggle(int32 FlagIndex)
+  {
+    Words[FlagIndex / BitsPerWord] ^= static_cast<WordType>(WordType(1) << (FlagIndex % BitsPerWord));
+  }
+
+  FORCEINLINE constexpr bool Test(int32 FlagIndex) const
+  {
+    return (Words[FlagIndex / BitsPerWord] >> (FlagIndex % BitsPerWord)) & 1;
+  }
+
+  /** True if every flag of Other is set */
+  FORCEINLINE constexpr bool HasAll(const TStatusFlagSet& Other) const
+  {
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      if ((Words[WordIndex] & Other.Words[WordIndex]) != Other.Words[WordIndex]) return false;
+    }
+    return true;
+  }
+
+  /** True if at least one flag of Other is set */
+  FORCEINLINE constexpr bool HasAny(const TStatusFlagSet& Other) const
+  {
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      if (Words[WordIndex] & Other.Words[WordIndex]) return true;
+    }
+    return false;
+  }
+
+  /** True if no flag is set */
+  FORCEINLINE constexpr bool IsEmpty() const
+  {
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      if (Words[WordIndex]) return false;
+    }
+    return true;
+  }
+
+  /** True if every flag of MustHave and none of MustNotHave is set */
+  FORCEINLINE constexpr bool CanPerformAction(const TStatusFlagSet& MustHave, const TStatusFlagSet& MustNotHave) const
+  {
+    return HasAll(MustHave) && !HasAny(MustNotHave);
+  }
+
+  /** Number of set flags */
+  FORCEINLINE constexpr int32 CountSetFlags() const
+  {
+    int32 Count = 0;
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      Count += std::popcount(Words[WordIndex]);
+    }
+    return Count;
+  }
+
+  /** Calls Func(FlagIndex) for every set flag, in ascending order */
+  template <typename FuncType>
+  FORCEINLINE constexpr void ForEachSetFlag(FuncType&& Func) const
+  {
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      for (WordType Word = Words[WordIndex]; Word; Word = static_cast<WordType>(Word & (Word - 1)))
+      {
+        Func(WordIndex * BitsPerWord + std::countr_zero(Word));
+      }
+    }
+  }
+
+  /** Raw storage word, used by serializers and the 8-bit fast path */
+  FORCEINLINE constexpr WordType GetWord(int32 WordIndex) const { return Words[WordIndex]; }
+  FORCEINLINE constexpr void SetWord(int32 WordIndex, WordType Word)
+  {
+    Words[WordIndex] = WordIndex == NumWords - 1 ? static_cast<WordType>(Word & LastWordMask) : Word;
+  }
+
+  constexpr TStatusFlagSet operator|(const TStatusFlagSet& Other) const
+  {
+    TStatusFlagSet Result;
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      Result.Words[WordIndex] = static_cast<WordType>(Words[WordIndex] | Other.Words[WordIndex]);
+    }
+    return Result;
+  }
+
+  constexpr TStatusFlagSet operator&(const TStatusFlagSet& Other) const
+  {
+    TStatusFlagSet Result;
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      Result.Words[WordIndex] = static_cast<WordType>(Words[WordIndex] & Other.Words[WordIndex]);
+    }
+    return Result;
+  }
+
+  constexpr TStatusFlagSet operator^(const TStatusFlagSet& Other) const
+  {
+    TStatusFlagSet Result;
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      Result.Words[WordIndex] = static_cast<WordType>(Words[WordIndex] ^ Other.Words[WordIndex]);
+    }
+    return Result;
+  }
+
+  constexpr TStatusFlagSet operator~() const
+  {
+    TStatusFlagSet Result;
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      Result.Words[WordIndex] = static_cast<WordType>(~Words[WordIndex]);
+    }
+    Result.Words[NumWords - 1] &= LastWordMask;
+    return Result;
+  }
+
+  constexpr TStatusFlagSet& operator|=(const TStatusFlagSet& Other) { return *this = *this | Other; }
+  constexpr TStatusFlagSet& operator&=(const TStatusFlagSet& Other) { return *this = *this & Other; }
+  constexpr TStatusFlagSet& operator^=(const TStatusFlagSet& Other) { return *this = *this ^ Other; }
+
+  constexpr bool operator==(const TStatusFlagSet& Other) const
+  {
+    for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+    {
+      if (Words[WordIndex] != Other.Words[WordIndex]) return false;
+    }
+    return true;
+  }
+
+  constexpr bool operator!=(const TStatusFlagSet& Other) const { return !(*this == Other); }
+
+  /** Flags that are set in New but not in Old */
+  static constexpr TStatusFlagSet Added(const TStatusFlagSet& Old, const TStatusFlagSet& New) { return New & ~Old; }
+
+  /** Flags that are set in Old but not in New */
+  static constexpr TStatusFlagSet Removed(const TStatusFlagSet& Old, const TStatusFlagSet& New) { return Old & ~New; }
+
+private:
+  WordType Words[NumWords];
+};
+
+/** Number of game-defined flags available in the extended flag set */
+#ifndef STATUS_EXTENDED_FLAG_COUNT
+#define STATUS_EXTENDED_FLAG_COUNT 128
+#endif
+
+/** The 8 core flags of EStatusFlags */
+using FStatusCoreFlagSet = TStatusFlagSet<8>;
+
+/** Game-defined states beyond the core flags */
+using FStatusExtendedFlagSet = TStatusFlagSet<STATUS_EXTENDED_FLAG_COUNT>;
+
+static_assert(sizeof(FStatusCoreFlagSet) == sizeof(uint8), "The core flag set must stay as small as EStatusFlags");
+static_assert(FStatusCoreFlagSet::FromBits(0xA5).CountSetFlags() == 4, "Flag sets must be usable in constant expressions");
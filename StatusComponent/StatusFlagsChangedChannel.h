@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProxyEventChannel.h"
+
+class UStatusComponent;
+struct FStatusFlagsDiff;
+
+/**
+ * Proxy based channel for hot C++ listeners of status changes, see TProxyEventChannel
+ * A class of its own so StatusComponent.h can forward-declare it and stays free of proxy.h
+ */
+class FStatusFlagsChangedChannel : public TProxyEventChannel<UStatusComponent*, const FStatusFlagsDiff&>
+{
+};
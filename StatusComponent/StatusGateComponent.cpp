@@ -0,0 +1,263 @@
+#include "StatusGateComponent.h"
+#include "StatusComponent.h"
+#include "StatusFlagsChangedChannel.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/MovementComponent.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(StatusGateComponent)
+
+// Must match FootStep::GatedTag in FootStepNotify.cpp
+const FName UStatusGateComponent::FootstepGateTag(TEXT("FootStep.Gated"));
+
+namespace StatusGate
+{
+   static bool IsEmpty(const FStatusGateRule& Rule)
+   {
+       return !Rule.bDisableComponentTicks && Rule.ComponentTickInterval <= 0.0f
+           && !Rule.bPauseAnimations && !Rule.bOnlyAnimateWhenRendered && !Rule.bSuppressFootsteps;
+   }
+
+   static bool IsSameEffect(const FStatusGateRule& A, const FStatusGateRule& B)
+   {
+       return A.bDisableComponentTicks == B.bDisableComponentTicks
+           && A.ComponentTickInterval == B.ComponentTickInterval
+           && A.bGateActorTick == B.bGateActorTick
+           && A.bPauseAnimations == B.bPauseAnimations
+           && A.bOnlyAnimateWhenRendered == B.bOnlyAnimateWhenRendered
+           && A.bSuppressFootsteps == B.bSuppressFootsteps;
+   }
+}
+
+UStatusGateComponent::UStatusGateComponent()
+{
+   // Driven by status transitions only
+   PrimaryComponentTick.bCanEverTick = false;
+
+   // Death montages and ragdolls still need the mesh and movement, only the rest of the owner stops
+   IgnoredComponentClasses.Add(USkeletalMeshComponent::StaticClass());
+   IgnoredComponentClasses.Add(UMovementComponent::StaticClass());
+
+   FStatusGateRule& DeadRule = Rules.AddDefaulted_GetRef();
+   DeadRule.TriggerFlags = static_cast<uint8>(EStatusFlags::IsDead);
+   DeadRule.bDisableComponentTicks = true;
+   DeadRule.bSuppressFootsteps = true;
+
+   // Cinematics drive their characters, only the off-screen work is cut
+   FStatusGateRule& CinematicRule = Rules.AddDefaulted_GetRef();
+   CinematicRule.TriggerFlags = static_cast<uint8>(EStatusFlags::IsInCinematic);
+   CinematicRule.bOnlyAnimateWhenRendered = true;
+}
+
+void UStatusGateComponent::BeginPlay()
+{
+   Super::BeginPlay();
+
+   UStatusComponent* Status = GetOwner()->FindComponentByClass<UStatusComponent>();
+   if (!Status) return;
+
+   StatusComponent = Status;
+   StatusListener = Status->GetStatusFlagsChangedChannel().AddUObject(this, &UStatusGateComponent::HandleStatusFlagsChanged);
+   ApplyGate(Status->GetCoreStatusFlags().GetWord(0));
+}
+
+void UStatusGateComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+   if (UStatusComponent* Status = StatusComponent.Get())
+   {
+       Status->GetStatusFlagsChangedChannel().Remove(StatusListener);
+   }
+   StatusComponent.Reset();
+
+   RestoreOwner();
+   Super::EndPlay(EndPlayReason);
+}
+
+void UStatusGateComponent::HandleStatusFlagsChanged(UStatusComponent* InStatusComponent, const FStatusFlagsDiff& Diff)
+{
+   ApplyGate(Diff.NewFlags);
+}
+
+void UStatusGateComponent::ApplyGate(uint8 Flags)
+{
+   const FStatusGateRule Rule = CombineRules(Flags);
+   const bool bShouldApply = !StatusGate::IsEmpty(Rule);
+
+   // Most transitions do not touch a gated flag
+   if (bShouldApply == bGateApplied && (!bShouldApply || StatusGate::IsSameEffect(Rule, AppliedRule))) return;
+
+   RestoreOwner();
+   if (bShouldApply)
+   {
+       ApplyRule(Rule);
+   }
+}
+
+FStatusGateRule UStatusGateComponent::CombineRules(uint8 Flags) const
+{
+   FStatusGateRule Combined;
+   Combined.bGateActorTick = false;
+   for (const FStatusGateRule& Rule : Rules)
+   {
+       if (!(Rule.TriggerFlags & Flags)) continue;
+
+       Combined.bDisableComponentTicks |= Rule.bDisableComponentTicks;
+       Combined.ComponentTickInterval = FMath::Max(Combined.ComponentTickInterval, Rule.ComponentTickInterval);
+       Combined.bGateActorTick |= Rule.bGateActorTick;
+       Combined.bPauseAnimations |= Rule.bPauseAnimations;
+       Combined.bOnlyAnimateWhenRendered |= Rule.bOnlyAnimateWhenRendered;
+       Combined.bSuppressFootsteps |= Rule.bSuppressFootsteps;
+   }
+   return Combined;
+}
+
+void UStatusGateComponent::ApplyRule(const FStatusGateRule& Rule)
+{
+   AActor* Owner = GetOwner();
+   AppliedRule = Rule;
+   bGateApplied = true;
+
+   const bool bGateTicks = Rule.bDisableComponentTicks || Rule.ComponentTickInterval > 0.0f;
+   if (bGateTicks)
+   {
+       if (Rule.bGateActorTick && Owner->PrimaryActorTick.bCanEverTick)
+       {
+           bActorTickSaved = true;
+           bSavedActorTickEnabled = Owner->IsActorTickEnabled();
+           SavedActorTickInterval = Owner->GetActorTickInterval();
+           bActorTickDisabled = Rule.bDisableComponentTicks;
+           if (bActorTickDisabled)
+           {
+               Owner->SetActorTickEnabled(false);
+           }
+           else
+           {
+               AppliedActorTickInterval = FMath::Max(SavedActorTickInterval, Rule.ComponentTickInterval);
+               Owner->SetActorTickInterval(AppliedActorTickInterval);
+           }
+       }
+
+       for (UActorComponent* Component : Owner->GetComponents())
+       {
+           if (!Component || !Component->PrimaryComponentTick.bCanEverTick || IsIgnored(Component)) continue;
+
+           FSavedTickState& Saved = SavedTicks.AddDefaulted_GetRef();
+           Saved.Component = Component;
+           Saved.TickInterval = Component->GetComponentTickInterval();
+           Saved.bTickEnabled = Component->IsComponentTickEnabled();
+           Saved.bDisabledTick = Rule.bDisableComponentTicks;
+           if (Saved.bDisabledTick)
+           {
+               Component->SetComponentTickEnabled(false);
+           }
+           else
+           {
+               Saved.AppliedTickInterval = FMath::Max(Saved.TickInterval, Rule.ComponentTickInterval);
+               Component->SetComponentTickInterval(Saved.AppliedTickInterval);
+           }
+       }
+   }
+
+   if (Rule.bPauseAnimations || Rule.bOnlyAnimateWhenRendered || Rule.bSuppressFootsteps)
+   {
+       TInlineComponentArray<USkeletalMeshComponent*> Meshes(Owner);
+       for (USkeletalMeshComponent* Mesh : Meshes)
+       {
+           FSavedMeshState& Saved = SavedMeshes.AddDefaulted_GetRef();
+           Saved.Mesh = Mesh;
+           Saved.TickOption = Mesh->VisibilityBasedAnimTickOption;
+           Saved.bPauseAnims = Mesh->bPauseAnims;
+
+           if (Rule.bPauseAnimations)
+           {
+               Mesh->bPauseAnims = true;
+               Saved.bAppliedPauseAnims = true;
+           }
+           if (Rule.bOnlyAnimateWhenRendered)
+           {
+               Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+               Saved.bAppliedTickOption = true;
+           }
+           if (Rule.bSuppressFootsteps && !Mesh->ComponentHasTag(FootstepGateTag))
+           {
+               Mesh->ComponentTags.Add(FootstepGateTag);
+               Saved.bAddedFootstepTag = true;
+           }
+       }
+   }
+}
+
+void UStatusGateComponent::RestoreOwner()
+{
+   if (!bGateApplied) return;
+   bGateApplied = false;
+
+   AActor* Owner = GetOwner();
+   // Values changed by someone else while gated (a revive enabling the tick, a new tick rate...) are left alone
+   if (bActorTickSaved && Owner)
+   {
+       if (bActorTickDisabled)
+       {
+           if (!Owner->IsActorTickEnabled())
+           {
+               Owner->SetActorTickEnabled(bSavedActorTickEnabled);
+           }
+       }
+       else if (Owner->GetActorTickInterval() == AppliedActorTickInterval)
+       {
+           Owner->SetActorTickInterval(SavedActorTickInterval);
+       }
+   }
+   bActorTickSaved = false;
+   bActorTickDisabled = false;
+
+   for (const FSavedTickState& Saved : SavedTicks)
+   {
+       UActorComponent* Component = Saved.Component.Get();
+       if (!Component) continue;
+
+       if (Saved.bDisabledTick)
+       {
+           if (!Component->IsComponentTickEnabled())
+           {
+               Component->SetComponentTickEnabled(Saved.bTickEnabled);
+           }
+       }
+       else if (Component->GetComponentTickInterval() == Saved.AppliedTickInterval)
+       {
+           Component->SetComponentTickInterval(Saved.TickInterval);
+       }
+   }
+   SavedTicks.Reset();
+
+   for (const FSavedMeshState& Saved : SavedMeshes)
+   {
+       if (USkeletalMeshComponent* Mesh = Saved.Mesh.Get())
+       {
+           if (Saved.bAppliedTickOption && Mesh->VisibilityBasedAnimTickOption == EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered)
+           {
+               Mesh->VisibilityBasedAnimTickOption = Saved.TickOption;
+           }
+           if (Saved.bAppliedPauseAnims && Mesh->bPauseAnims)
+           {
+               Mesh->bPauseAnims = Saved.bPauseAnims;
+           }
+           if (Saved.bAddedFootstepTag)
+           {
+               Mesh->ComponentTags.Remove(FootstepGateTag);
+           }
+       }
+   }
+   SavedMeshes.Reset();
+}
+
+bool UStatusGateComponent::IsIgnored(const UActorComponent* Component) const
+{
+   // The status component ticks for its deferred events, it must keep sending the transitions that restore the gate
+   if (Component == this || Component == StatusComponent.Get()) return true;
+
+   for (const TSubclassOf<UActorComponent>& IgnoredClass : IgnoredComponentClasses)
+   {
+       if (IgnoredClass && Component->IsA(IgnoredClass)) return true;
+   }
+   return false;
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Components/SkinnedMeshComponent.h"
+#include "ProxyEventHandle.h"
+#include "StatusGateComponent.generated.h"
+
+class UStatusComponent;
+class USkeletalMeshComponent;
+struct FStatusFlagsDiff;
+
+/**
+ * What a gate does to its owner while one of the trigger flags is set
+ */
+USTRUCT(BlueprintType)
+struct FStatusGateRule
+{
+  GENERATED_BODY()
+
+  /** The rule is active while any of these flags is set */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 TriggerFlags = 0;
+
+  /** If true, the ticks of the owner's components are disabled */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status")
+  bool bDisableComponentTicks = false;
+
+  /** Minimum tick interval of the owner's components while the rule is active, 0 keeps their rate */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (ClampMin = "0", EditCondition = "!bDisableComponentTicks"))
+  float ComponentTickInterval = 0.0f;
+
+  /** If true, the tick of the owning actor is gated like its components */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status")
+  bool bGateActorTick = true;
+
+  /** If true, skeletal meshes stop animating, which also stops their animation notifies */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status")
+  bool bPauseAnimations = false;
+
+  /** If true, skeletal meshes only update their pose and notifies while rendered */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status")
+  bool bOnlyAnimateWhenRendered = false;
+
+  /** If true, footstep notifies of the owner's meshes skip their traces and effects */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status")
+  bool bSuppressFootsteps = false;
+};
+
+/**
+ * StatusGateComponent - Lowers the cost of characters that are dead, in a cinematic, etc.
+ * Listens to the status flag transitions of the owner's UStatusComponent and, while a rule is active, disables or slows
+ * down the owner's ticks, animations and footsteps. Everything is restored when the flags are cleared.
+ * Nothing is polled: the component never ticks and only works when the flags change.
+ * Components added to the owner while a gate is applied are not gated.
+ * On restore, a value is only reverted if it still holds what the gate set, changes made by gameplay meanwhile are kept.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class GAME_API UStatusGateComponent : public UActorComponent
+{
+  GENERATED_BODY()
+
+public:
+  UStatusGateComponent();
+
+  /** Tag added to the owner's skeletal meshes while footsteps are suppressed, checked by UFootStepNotify */
+  static const FName FootstepGateTag;
+
+  virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+  /** Rules of the gate, active rules are combined and the strongest restriction wins */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status|Gate")
+  TArray<FStatusGateRule> Rules;
+
+  /**
+   * Component classes whose ticks are never gated (audio, ragdoll physics...)
+   * Defaults to skeletal meshes and movement so death montages and ragdolls keep updating, mesh animations are only
+   * changed by the animation options of the rules.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status|Gate")
+  TArray<TSubclassOf<UActorComponent>> IgnoredComponentClasses;
+
+  /** True while at least one rule is applied to the owner */
+  UFUNCTION(BlueprintPure, Category = "Status|Gate")
+  bool IsGated() const { return bGateApplied; }
+
+  /**
+   * Applies the rules matching a set of flags, called on every status transition
+   * @param Flags - Current status flags of the owner
+   */
+  void ApplyGate(uint8 Flags);
+
+private:
+  /** Tick state of a component before it was gated */
+  struct FSavedTickState
+  {
+    TWeakObjectPtr<UActorComponent> Component;
+    float TickInterval = 0.0f;
+    bool bTickEnabled = false;
+    /** Interval set by the gate, unused when the tick was disabled */
+    float AppliedTickInterval = 0.0f;
+    bool bDisabledTick = false;
+  };
+
+  /** Animation state of a mesh before it was gated */
+  struct FSavedMeshState
+  {
+    TWeakObjectPtr<USkeletalMeshComponent> Mesh;
+    EVisibilityBasedAnimTickOption TickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+    bool bPauseAnims = false;
+    bool bAppliedTickOption = false;
+    bool bAppliedPauseAnims = false;
+    bool bAddedFootstepTag = false;
+  };
+
+  void HandleStatusFlagsChanged(UStatusComponent* InStatusComponent, const FStatusFlagsDiff& Diff);
+
+  /** Combines the rules matching the flags into one */
+  FStatusGateRule CombineRules(uint8 Flags) const;
+
+  void ApplyRule(const FStatusGateRule& Rule);
+  void RestoreOwner();
+  bool IsIgnored(const UActorComponent* Component) const;
+
+  TWeakObjectPtr<UStatusComponent> StatusComponent;
+  FProxyEventHandle StatusListener;
+
+  /** Combined rule currently applied */
+  FStatusGateRule AppliedRule;
+  bool bGateApplied = false;
+
+  TArray<FSavedTickState> SavedTicks;
+  TArray<FSavedMeshState> SavedMeshes;
+  float SavedActorTickInterval = 0.0f;
+  float AppliedActorTickInterval = 0.0f;
+  bool bSavedActorTickEnabled = false;
+  bool bActorTickDisabled = false;
+  bool bActorTickSaved = false;
+};
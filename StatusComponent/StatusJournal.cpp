@@ -0,0 +1,247 @@
+#include "StatusJournal.h"
+#include "StatusComponent.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Paths.h"
+#include "Misc/DateTime.h"
+
+std::atomic<FStatusJournal*> FStatusJournal::Instance{ nullptr };
+std::atomic<uint32> FStatusJournal::Generation{ 0 };
+
+namespace StatusJournal
+{
+   /** Ring of the calling thread and the journal generation it belongs to */
+   struct FThreadRingSlot
+   {
+       void* Ring = nullptr;
+       uint32 Generation = 0;
+   };
+   static thread_local FThreadRingSlot ThreadRingSlot;
+}
+
+// Recording
+bool FStatusJournal::StartRecording(const FString& FilePath)
+{
+   if (IsRecording()) return false;
+
+   IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+   PlatformFile.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+
+   IFileHandle* File = PlatformFile.OpenWrite(*FilePath);
+   if (!File) return false;
+
+   const FStatusJournalFileHeader Header;
+   File->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+   FStatusJournal* Journal = new FStatusJournal(File);
+   Journal->Thread = FRunnableThread::Create(Journal, TEXT("StatusJournal"), 0, TPri_BelowNormal);
+   Instance.store(Journal, std::memory_order_release);
+   return true;
+}
+
+void FStatusJournal::StopRecording()
+{
+   FStatusJournal* Journal = Instance.exchange(nullptr, std::memory_order_acq_rel);
+   if (!Journal) return;
+
+   // Joining the thread runs the final drain
+   Journal->Thread->Kill(true);
+   delete Journal;
+}
+
+void FStatusJournal::Record(uint32 ComponentId, uint8 OldFlags, uint8 NewFlags, EStatusChangeCause Cause)
+{
+   FStatusJournal* Journal = Instance.load(std::memory_order_acquire);
+   if (!Journal) return;
+
+   FProducerRing* Ring = Journal->GetThreadRing();
+   const uint32 WriteIndex = Ring->WriteIndex.load(std::memory_order_relaxed);
+   if (WriteIndex - Ring->ReadIndex.load(std::memory_order_acquire) >= FProducerRing::Capacity)
+   {
+       Ring->NumDropped.fetch_add(1, std::memory_order_relaxed);
+       return;
+   }
+
+   FStatusJournalRecord& Record = Ring->Records[WriteIndex % FProducerRing::Capacity];
+   Record.Timestamp = FPlatformTime::Seconds();
+   Record.ComponentId = ComponentId;
+   Record.OldFlags = OldFlags;
+   Record.NewFlags = NewFlags;
+   Record.Cause = Cause;
+   Record.Reserved = 0;
+   Ring->WriteIndex.store(WriteIndex + 1, std::memory_order_release);
+}
+
+FStatusJournal::FStatusJournal(IFileHandle* InFile)
+   : File(InFile)
+   , WakeEvent(FPlatformProcess::GetSynchEventFromPool())
+   , JournalGeneration(Generation.fetch_add(1) + 1)
+{
+}
+
+FStatusJournal::~FStatusJournal()
+{
+   delete Thread;
+   FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+   delete File;
+
+   uint64 NumDropped = 0;
+   for (const TUniquePtr<FProducerRing>& Ring : Rings)
+   {
+       NumDropped += Ring->NumDropped.load();
+   }
+   if (NumDropped > 0)
+   {
+       UE_LOG(LogTemp, Warning, TEXT("Status journal dropped %llu records, the rings were full"), NumDropped);
+   }
+}
+
+FStatusJournal::FProducerRing* FStatusJournal::GetThreadRing()
+{
+   StatusJournal::FThreadRingSlot& Slot = StatusJournal::ThreadRingSlot;
+   if (Slot.Generation != JournalGeneration)
+   {
+       TUniquePtr<FProducerRing> NewRing = MakeUnique<FProducerRing>();
+       Slot.Ring = NewRing.Get();
+       Slot.Generation = JournalGeneration;
+
+       FScopeLock Lock(&RingsLock);
+       Rings.Add(MoveTemp(NewRing));
+   }
+   return static_cast<FProducerRing*>(Slot.Ring);
+}
+
+// Consumer thread
+uint32 FStatusJournal::Run()
+{
+   while (!bStopRequested.load(std::memory_order_acquire))
+   {
+       DrainRings();
+       WakeEvent->Wait(FTimespan::FromMilliseconds(10));
+   }
+   DrainRings();
+   File->Flush();
+   return 0;
+}
+
+void FStatusJournal::Stop()
+{
+   bStopRequested.store(true, std::memory_order_release);
+   WakeEvent->Trigger();
+}
+
+void FStatusJournal::DrainRings()
+{
+   // Rings live until the journal is destroyed, so the lock is only held to copy the list
+   TArray<FProducerRing*, TInlineAllocator<32>> RingsToDrain;
+   {
+       FScopeLock Lock(&RingsLock);
+       for (const TUniquePtr<FProducerRing>& Ring : Rings)
+       {
+           RingsToDrain.Add(Ring.Get());
+       }
+   }
+
+   for (FProducerRing* Ring : RingsToDrain)
+   {
+       const uint32 ReadIndex = Ring->ReadIndex.load(std::memory_order_relaxed);
+       const uint32 WriteIndex = Ring->WriteIndex.load(std::memory_order_acquire);
+       if (ReadIndex == WriteIndex) continue;
+
+       // At most two contiguous spans because of the wrap-around
+       const uint32 Start = ReadIndex % FProducerRing::Capacity;
+       const uint32 Count = WriteIndex - ReadIndex;
+       const uint32 FirstSpan = FMath::Min(Count, FProducerRing::Capacity - Start);
+       File->Write(reinterpret_cast<const uint8*>(&Ring->Records[Start]), FirstSpan * sizeof(FStatusJournalRecord));
+       if (Count > FirstSpan)
+       {
+           File->Write(reinterpret_cast<const uint8*>(&Ring->Records[0]), (Count - FirstSpan) * sizeof(FStatusJournalRecord));
+       }
+
+       Ring->ReadIndex.store(WriteIndex, std::memory_order_release);
+   }
+}
+
+// Reader
+FStatusJournalReader::~FStatusJournalReader()
+{
+   // The region must be released before its file
+   MappedRegion.Reset();
+   MappedFile.Reset();
+}
+
+bool FStatusJournalReader::Open(const FString& FilePath)
+{
+   Records = {};
+   MappedRegion.Reset();
+   MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+   if (!MappedFile || MappedFile->GetFileSize() < static_cast<int64>(sizeof(FStatusJournalFileHeader))) return false;
+
+   MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+   if (!MappedRegion) return false;
+
+   const uint8* Data = MappedRegion->GetMappedPtr();
+   const FStatusJournalFileHeader* Header = reinterpret_cast<const FStatusJournalFileHeader*>(Data);
+   if (Header->Magic != FStatusJournalFileHeader::ExpectedMagic
+       || Header->Version != FStatusJournalFileHeader::CurrentVersion
+       || Header->RecordSize != sizeof(FStatusJournalRecord))
+   {
+       return false;
+   }
+
+   const int64 NumRecords = (MappedRegion->GetMappedSize() - sizeof(FStatusJournalFileHeader)) / sizeof(FStatusJournalRecord);
+   Records = MakeArrayView(reinterpret_cast<const FStatusJournalRecord*>(Data + sizeof(FStatusJournalFileHeader)), static_cast<int32>(NumRecords));
+   return true;
+}
+
+void FStatusJournalReader::BuildTimeline(uint32 ComponentId, TArray<FStatusJournalRecord>& OutTimeline) const
+{
+   OutTimeline.Reset();
+   for (const FStatusJournalRecord& Record : Records)
+   {
+       if (Record.ComponentId == ComponentId)
+       {
+           OutTimeline.Add(Record);
+       }
+   }
+
+   // Records of different threads are interleaved in the file
+   OutTimeline.StableSort([](const FStatusJournalRecord& A, const FStatusJournalRecord& B) { return A.Timestamp < B.Timestamp; });
+}
+
+uint8 FStatusJournalReader::GetFlagsAt(uint32 ComponentId, double Timestamp) const
+{
+   // The latest transition before the timestamp holds the flags
+   double LatestTimestamp = -UE_DOUBLE_BIG_NUMBER;
+   uint8 Flags = 0;
+   for (const FStatusJournalRecord& Record : Records)
+   {
+       if (Record.ComponentId == ComponentId && Record.Timestamp <= Timestamp && Record.Timestamp >= LatestTimestamp)
+       {
+           LatestTimestamp = Record.Timestamp;
+           Flags = Record.NewFlags;
+       }
+   }
+   return Flags;
+}
+
+// Console commands
+static FAutoConsoleCommand StatusJournalStartCommand(
+   TEXT("Status.Journal.Start"),
+   TEXT("Starts recording status transitions. Optional argument: output file."),
+   FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+   {
+       const FString FilePath = Args.Num() > 0
+           ? Args[0]
+           : FPaths::ProjectSavedDir() / TEXT("StatusJournal") / FString::Printf(TEXT("StatusJournal_%s.bin"), *FDateTime::Now().ToString());
+       if (FStatusJournal::StartRecording(FilePath))
+       {
+           UE_LOG(LogTemp, Log, TEXT("Status journal recording to %s"), *FilePath);
+       }
+   }));
+
+static FAutoConsoleCommand StatusJournalStopCommand(
+   TEXT("Status.Journal.Stop"),
+   TEXT("Stops recording status transitions."),
+   FConsoleCommandDelegate::CreateStatic(&FStatusJournal::StopRecording));
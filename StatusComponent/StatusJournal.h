@@ -0,0 +1,159 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include <atomic>
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+enum class EStatusChangeCause : uint8;
+
+/**
+ * One status transition, written as-is to the journal file
+ */
+struct FStatusJournalRecord
+{
+  /** FPlatformTime::Seconds() at the time of the change */
+  double Timestamp;
+
+  /** Status component id (UStatusComponent::GetStatusComponentId), never reused within the process */
+  uint32 ComponentId;
+
+  uint8 OldFlags;
+  uint8 NewFlags;
+  EStatusChangeCause Cause;
+  uint8 Reserved;
+};
+static_assert(sizeof(FStatusJournalRecord) == 16, "Journal records are written and mapped as raw 16 byte entries");
+
+/**
+ * Header at the start of every journal file, followed by tightly packed FStatusJournalRecord entries
+ */
+struct FStatusJournalFileHeader
+{
+  static constexpr uint32 ExpectedMagic = 0x4C4E4A53; // "SJNL"
+  static constexpr uint32 CurrentVersion = 1;
+
+  uint32 Magic = ExpectedMagic;
+  uint32 Version = CurrentVersion;
+  uint32 RecordSize = sizeof(FStatusJournalRecord);
+  uint32 Reserved = 0;
+};
+static_assert(sizeof(FStatusJournalFileHeader) == 16, "The header keeps the records 16 byte aligned");
+
+/**
+ * StatusJournal - Optional record of every status transition for telemetry, bug replay and anti-cheat checks
+ * Producers (any thread) append to their own single-producer/single-consumer ring buffer, a background thread
+ * drains all rings into a binary file. Recording never blocks: when a ring is full the record is dropped and counted.
+ * When the journal is not running, the cost for the status component is one atomic load.
+ * Started and stopped with the Status.Journal.Start [File] and Status.Journal.Stop console commands.
+ */
+class GAME_API FStatusJournal : public FRunnable
+{
+public:
+  /**
+   * Starts recording into a new file
+   * @param FilePath - Journal file to create
+   * @return True if the file could be created
+   */
+  static bool StartRecording(const FString& FilePath);
+
+  /**
+   * Stops recording, flushes every ring and closes the file
+   * Must not run concurrently with threads that still change status flags
+   */
+  static void StopRecording();
+
+  /** True while a journal is recording */
+  static FORCEINLINE bool IsRecording() { return Instance.load(std::memory_order_relaxed) != nullptr; }
+
+  /**
+   * Appends a transition to the calling thread's ring buffer
+   * @param ComponentId - Status component id of the component
+   * @param OldFlags - Flags before the change
+   * @param NewFlags - Flags after the change
+   * @param Cause - Operation that caused the change
+   */
+  static void Record(uint32 ComponentId, uint8 OldFlags, uint8 NewFlags, EStatusChangeCause Cause);
+
+  virtual ~FStatusJournal() override;
+
+  // FRunnable Interface
+  virtual uint32 Run() override;
+  virtual void Stop() override;
+
+private:
+  /** Ring buffer written by one thread and read by the journal thread */
+  struct FProducerRing
+  {
+    static constexpr uint32 Capacity = 4096;
+
+    FStatusJournalRecord Records[Capacity];
+    std::atomic<uint32> WriteIndex{ 0 };
+    std::atomic<uint32> ReadIndex{ 0 };
+    std::atomic<uint64> NumDropped{ 0 };
+  };
+
+  explicit FStatusJournal(IFileHandle* InFile);
+
+  /** Returns the ring of the calling thread, creating it on first use */
+  FProducerRing* GetThreadRing();
+
+  /** Writes every pending record of every ring to the file */
+  void DrainRings();
+
+  static std::atomic<FStatusJournal*> Instance;
+
+  /** Incremented on every start so stale thread-local rings of a previous journal are never reused */
+  static std::atomic<uint32> Generation;
+
+  /** Rings of every producer thread, only added while holding RingsLock */
+  TArray<TUniquePtr<FProducerRing>> Rings;
+  FCriticalSection RingsLock;
+
+  IFileHandle* File = nullptr;
+  FRunnableThread* Thread = nullptr;
+  FEvent* WakeEvent = nullptr;
+  std::atomic<bool> bStopRequested{ false };
+  uint32 JournalGeneration = 0;
+};
+
+/**
+ * StatusJournalReader - Memory-maps a journal file and rebuilds component timelines offline
+ */
+class GAME_API FStatusJournalReader
+{
+public:
+  ~FStatusJournalReader();
+
+  /**
+   * Maps a journal file
+   * @param FilePath - Journal written by FStatusJournal
+   * @return True if the file is a valid journal
+   */
+  bool Open(const FString& FilePath);
+
+  /** Every record of the file, grouped by producer thread and ordered by time within each group */
+  FORCEINLINE TConstArrayView<FStatusJournalRecord> GetRecords() const { return Records; }
+
+  /**
+   * Collects the transitions of one component in time order
+   * @param ComponentId - Status component id of the component
+   * @param OutTimeline - Receives the component's records sorted by timestamp
+   */
+  void BuildTimeline(uint32 ComponentId, TArray<FStatusJournalRecord>& OutTimeline) const;
+
+  /**
+   * Replays a component's transitions up to a point in time
+   * @param ComponentId - Status component id of the component
+   * @param Timestamp - Time to replay to
+   * @return The flags of the component at that time, 0 if it had no transition before
+   */
+  uint8 GetFlagsAt(uint32 ComponentId, double Timestamp) const;
+
+private:
+  TUniquePtr<IMappedFileHandle> MappedFile;
+  TUniquePtr<IMappedFileRegion> MappedRegion;
+  TConstArrayView<FStatusJournalRecord> Records;
+};
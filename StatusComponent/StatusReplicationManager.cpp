@@ -0,0 +1,262 @@
+#include "StatusReplicationManager.h"
+#include "StatusComponent.h"
+#include "StatusWorldSubsystem.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(StatusReplicationManager)
+
+// Replicated state
+void FStatusReplicatedState::SetRemainingTime(int32 BitIndex, float Seconds)
+{
+   const int32 Quantized = FMath::CeilToInt(Seconds / DurationStep);
+   QuantizedRemaining[BitIndex] = static_cast<uint16>(FMath::Clamp(Quantized, 1, static_cast<int32>(MAX_uint16)));
+}
+
+bool FStatusReplicatedState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+   Ar << Flags;
+
+   // Most components have no timed flag, a single bit covers that case
+   uint8 bHasTimedFlags = TimedMask != 0;
+   Ar.SerializeBits(&bHasTimedFlags, 1);
+
+   if (bHasTimedFlags)
+   {
+       Ar << TimedMask;
+       for (uint32 Bits = TimedMask; Bits; Bits &= Bits - 1)
+       {
+           const int32 BitIndex = FMath::CountTrailingZeros(Bits);
+           uint32 Value = QuantizedRemaining[BitIndex];
+           Ar.SerializeIntPacked(Value);
+           QuantizedRemaining[BitIndex] = static_cast<uint16>(Value);
+       }
+   }
+   else if (Ar.IsLoading())
+   {
+       TimedMask = 0;
+   }
+
+   bOutSuccess = !Ar.IsError();
+   return true;
+}
+
+bool FStatusReplicatedState::operator==(const FStatusReplicatedState& Other) const
+{
+   if (Flags != Other.Flags || TimedMask != Other.TimedMask) return false;
+
+   for (uint32 Bits = TimedMask; Bits; Bits &= Bits - 1)
+   {
+       const int32 BitIndex = FMath::CountTrailingZeros(Bits);
+       if (QuantizedRemaining[BitIndex] != Other.QuantizedRemaining[BitIndex]) return false;
+   }
+   return true;
+}
+
+// Fast array callbacks, clients only
+void FStatusReplicationItem::PostReplicatedAdd(const FStatusReplicationArray& InArraySerializer)
+{
+   if (Component)
+   {
+       Component->ApplyReplicatedState(State);
+   }
+}
+
+void FStatusReplicationItem::PostReplicatedChange(const FStatusReplicationArray& InArraySerializer)
+{
+   if (Component)
+   {
+       Component->ApplyReplicatedState(State);
+   }
+}
+
+// Manager
+AStatusReplicationManager::AStatusReplicationManager()
+{
+   bReplicates = true;
+   bOnlyRelevantToOwner = true;
+   SetNetUpdateFrequency(30.0f);
+
+   // Only the server sends, so the tick is enabled on authority in BeginPlay
+   PrimaryActorTick.bCanEverTick = true;
+   PrimaryActorTick.bStartWithTickEnabled = false;
+}
+
+void AStatusReplicationManager::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+   Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+   DOREPLIFETIME(AStatusReplicationManager, StatusItems);
+}
+
+void AStatusReplicationManager::BeginPlay()
+{
+   Super::BeginPlay();
+   SetActorTickEnabled(HasAuthority());
+}
+
+void AStatusReplicationManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+   if (HasAuthority())
+   {
+       if (UStatusWorldSubsystem* StatusStore = GetWorld()->GetSubsystem<UStatusWorldSubsystem>())
+       {
+           StatusStore->RemoveReplicationManager(this);
+       }
+   }
+   Super::EndPlay(EndPlayReason);
+}
+
+APlayerController* AStatusReplicationManager::GetViewer() const
+{
+   return Cast<APlayerController>(GetOwner());
+}
+
+void AStatusReplicationManager::UpdateRelevancy(UStatusComponent* Component)
+{
+   const APlayerController* Viewer = GetViewer();
+   if (!Viewer) return;
+
+   FVector ViewLocation;
+   FRotator ViewRotation;
+   Viewer->GetPlayerViewPoint(ViewLocation, ViewRotation);
+   UpdateRelevancy(Component, Viewer, ViewLocation);
+}
+
+void AStatusReplicationManager::UpdateRelevancy(UStatusComponent* Component, const APlayerController* Viewer, const FVector& ViewLocation)
+{
+   const AActor* Owner = Component ? Component->GetOwner() : nullptr;
+   const bool bRelevant = Owner && Owner->IsNetRelevantFor(Viewer, Viewer->GetViewTarget(), ViewLocation);
+   const bool bReplicated = ItemIndexByComponent.Contains(Component);
+   if (bRelevant && !bReplicated)
+   {
+       AddComponent(Component);
+   }
+   else if (!bRelevant && bReplicated)
+   {
+       RemoveComponent(Component);
+   }
+}
+
+void AStatusReplicationManager::AddComponent(UStatusComponent* Component)
+{
+   check(HasAuthority());
+   if (!Component || ItemIndexByComponent.Contains(Component)) return;
+
+   const int32 ItemIndex = StatusItems.Items.AddDefaulted();
+   FStatusReplicationItem& Item = StatusItems.Items[ItemIndex];
+   Item.Component = Component;
+   Component->GetReplicatedState(Item.State);
+   Item.LastSendTime = GetWorld()->GetTimeSeconds();
+   StatusItems.MarkItemDirty(Item);
+
+   ItemIndexByComponent.Add(Component, ItemIndex);
+}
+
+void AStatusReplicationManager::RemoveComponent(UStatusComponent* Component)
+{
+   int32 ItemIndex = INDEX_NONE;
+   if (!ItemIndexByComponent.RemoveAndCopyValue(Component, ItemIndex)) return;
+
+   if (StatusItems.Items[ItemIndex].bPendingSend)
+   {
+       PendingItems.RemoveSingleSwap(ItemIndex, EAllowShrinking::No);
+   }
+
+   // Keep the index map and the pending list in sync with the item that takes over the freed slot
+   const int32 LastIndex = StatusItems.Items.Num() - 1;
+   if (ItemIndex != LastIndex)
+   {
+       const FStatusReplicationItem& Moved = StatusItems.Items[LastIndex];
+       ItemIndexByComponent.Add(Moved.Component, ItemIndex);
+       if (Moved.bPendingSend)
+       {
+           PendingItems[PendingItems.IndexOfByKey(LastIndex)] = ItemIndex;
+       }
+   }
+   StatusItems.Items.RemoveAtSwap(ItemIndex, 1, EAllowShrinking::No);
+   StatusItems.MarkArrayDirty();
+}
+
+void AStatusReplicationManager::MarkComponentDirty(UStatusComponent* Component)
+{
+   const int32* ItemIndex = ItemIndexByComponent.Find(Component);
+   if (!ItemIndex) return;
+
+   FStatusReplicationItem& Item = StatusItems.Items[*ItemIndex];
+   if (!Item.bPendingSend)
+   {
+       Item.bPendingSend = true;
+       PendingItems.Add(*ItemIndex);
+   }
+}
+
+void AStatusReplicationManager::Tick(float DeltaSeconds)
+{
+   Super::Tick(DeltaSeconds);
+
+   // The player left without a logout (seamless travel, destroyed controller)
+   const APlayerController* Viewer = GetViewer();
+   if (!Viewer)
+   {
+       Destroy();
+       return;
+   }
+
+   UWorld* World = GetWorld();
+   UStatusWorldSubsystem* StatusStore = World->GetSubsystem<UStatusWorldSubsystem>();
+   if (!StatusStore) return;
+
+   FVector ViewLocation;
+   FRotator ViewRotation;
+   Viewer->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+   // Round robin over the registered components, actors entering or leaving the player's relevancy add or drop their item
+   const TConstArrayView<TObjectPtr<UStatusComponent>> Components = StatusStore->GetReplicatedComponents();
+   const int32 NumChecks = FMath::Min(Components.Num(), FMath::Max(RelevancyChecksPerTick, 1));
+   for (int32 Check = 0; Check < NumChecks; ++Check)
+   {
+       if (RelevancyCursor >= Components.Num()) RelevancyCursor = 0;
+       UpdateRelevancy(Components[RelevancyCursor++], Viewer, ViewLocation);
+   }
+
+   if (PendingItems.Num() == 0) return;
+
+   const double Now = World->GetTimeSeconds();
+   const float NearDistanceSq = FMath::Square(NearDistance);
+   const float FarDistanceSq = FMath::Square(FarDistance);
+
+   // Items that are not due yet stay in the pending list, compacted in place
+   int32 NumStillPending = 0;
+   for (const int32 ItemIndex : PendingItems)
+   {
+       FStatusReplicationItem& Item = StatusItems.Items[ItemIndex];
+       if (const AActor* Owner = Item.Component ? Item.Component->GetOwner() : nullptr)
+       {
+           const float DistanceSq = static_cast<float>(FVector::DistSquared(ViewLocation, Owner->GetActorLocation()));
+           const float Interval = DistanceSq <= NearDistanceSq ? 0.0f
+               : DistanceSq <= FarDistanceSq ? MidUpdateInterval
+               : FarUpdateInterval;
+           if (Now - Item.LastSendTime < Interval)
+           {
+               PendingItems[NumStillPending++] = ItemIndex;
+               continue;
+           }
+       }
+
+       Item.bPendingSend = false;
+       Item.LastSendTime = Now;
+
+       // Only mark the item dirty if the quantized state really changed
+       FStatusReplicatedState NewState;
+       if (Item.Component)
+       {
+           Item.Component->GetReplicatedState(NewState);
+       }
+       if (NewState != Item.State)
+       {
+           Item.State = NewState;
+           StatusItems.MarkItemDirty(Item);
+       }
+   }
+   PendingItems.SetNum(NumStillPending, EAllowShrinking::No);
+}
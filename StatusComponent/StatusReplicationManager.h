@@ -0,0 +1,191 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "StatusReplicationManager.generated.h"
+
+class UStatusComponent;
+class UStatusWorldSubsystem;
+class APlayerController;
+struct FStatusReplicationArray;
+
+/**
+ * Replicated status of one component: the flag byte and the remaining time of its timed flags
+ * Remaining times are quantized to 1/10 s, only flags with a pending expiry send a duration.
+ */
+USTRUCT()
+struct GAME_API FStatusReplicatedState
+{
+  GENERATED_BODY()
+
+  /** Quantization step of remaining durations, in seconds */
+  static constexpr float DurationStep = 0.1f;
+
+  /** Current status flags */
+  uint8 Flags = 0;
+
+  /** Flags that have a pending expiry */
+  uint8 TimedMask = 0;
+
+  /** Remaining duration of every timed flag, in DurationStep units, indexed by bit */
+  uint16 QuantizedRemaining[8] = {};
+
+  /** Stores a remaining duration for the given flag bit */
+  void SetRemainingTime(int32 BitIndex, float Seconds);
+
+  /** Remaining duration of the given flag bit in seconds */
+  FORCEINLINE float GetRemainingTime(int32 BitIndex) const { return QuantizedRemaining[BitIndex] * DurationStep; }
+
+  bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+  bool operator==(const FStatusReplicatedState& Other) const;
+  bool operator!=(const FStatusReplicatedState& Other) const { return !(*this == Other); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FStatusReplicatedState> : public TStructOpsTypeTraitsBase2<FStatusReplicatedState>
+{
+  enum
+  {
+    WithNetSerializer = true,
+    WithIdenticalViaEquality = true,
+  };
+};
+
+/**
+ * One replicated status component inside the fast array
+ */
+USTRUCT()
+struct GAME_API FStatusReplicationItem : public FFastArraySerializerItem
+{
+  GENERATED_BODY()
+
+  /** Component whose status is replicated, resolved on clients once its actor is relevant */
+  UPROPERTY()
+  TObjectPtr<UStatusComponent> Component;
+
+  /** Replicated status */
+  UPROPERTY()
+  FStatusReplicatedState State;
+
+  /** Server only: world time of the last send */
+  double LastSendTime = 0.0;
+
+  /** Server only: the component changed since the last send */
+  bool bPendingSend = false;
+
+  void PostReplicatedAdd(const FStatusReplicationArray& InArraySerializer);
+  void PostReplicatedChange(const FStatusReplicationArray& InArraySerializer);
+};
+
+/**
+ * Fast array holding the status of every replicated component, only changed items are sent
+ */
+USTRUCT()
+struct GAME_API FStatusReplicationArray : public FFastArraySerializer
+{
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TArray<FStatusReplicationItem> Items;
+
+  bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+  {
+    return FFastArraySerializer::FastArrayDeltaSerialize<FStatusReplicationItem, FStatusReplicationArray>(Items, DeltaParams, *this);
+  }
+};
+
+template<>
+struct TStructOpsTypeTraits<FStatusReplicationArray> : public TStructOpsTypeTraitsBase2<FStatusReplicationArray>
+{
+  enum
+  {
+    WithNetDeltaSerializer = true,
+  };
+};
+
+/**
+ * StatusReplicationManager - Replicates the status flags of the status components relevant to one player
+ * Spawned by the world status store on the server for every remote player, owned by its player controller and only
+ * relevant to it. Instead of one replicated property per component, statuses are batched into one fast array that only
+ * holds the components whose owner is net relevant to that player (AActor::IsNetRelevantFor), so a connection never
+ * receives the statuses of actors it can't see. Relevancy is re-evaluated for RelevancyChecksPerTick components per tick.
+ * Changes are rate limited by the distance of the actor to the player's view: within NearDistance they are sent on the
+ * next tick, up to FarDistance at most once per MidUpdateInterval, beyond it at most once per FarUpdateInterval.
+ */
+UCLASS(Config = Game, NotPlaceable)
+class GAME_API AStatusReplicationManager : public AInfo
+{
+  GENERATED_BODY()
+
+public:
+  AStatusReplicationManager();
+
+  virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+  virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+  virtual void Tick(float DeltaSeconds) override;
+
+  /**
+   * Starts or stops replicating a component depending on whether its owner is relevant to the player, server only
+   * @param Component - Component registered for replication in the world status store
+   */
+  void UpdateRelevancy(UStatusComponent* Component);
+
+  /**
+   * Stops replicating a component, server only
+   * @param Component - Component to remove
+   */
+  void RemoveComponent(UStatusComponent* Component);
+
+  /**
+   * Queues the current status of a component for sending, server only
+   * @param Component - Component that changed
+   */
+  void MarkComponentDirty(UStatusComponent* Component);
+
+  /** Changes of actors within this distance of a player are sent right away */
+  UPROPERTY(Config, EditDefaultsOnly, Category = "Status|Replication")
+  float NearDistance = 3000.0f;
+
+  /** Changes of actors beyond this distance from every player use FarUpdateInterval */
+  UPROPERTY(Config, EditDefaultsOnly, Category = "Status|Replication")
+  float FarDistance = 10000.0f;
+
+  /** Minimum time between two sends of the same actor between NearDistance and FarDistance */
+  UPROPERTY(Config, EditDefaultsOnly, Category = "Status|Replication")
+  float MidUpdateInterval = 0.25f;
+
+  /** Minimum time between two sends of the same actor beyond FarDistance */
+  UPROPERTY(Config, EditDefaultsOnly, Category = "Status|Replication")
+  float FarUpdateInterval = 1.0f;
+
+  /** Number of registered components whose relevancy is checked every tick, in a round robin */
+  UPROPERTY(Config, EditDefaultsOnly, Category = "Status|Replication", meta = (ClampMin = "1"))
+  int32 RelevancyChecksPerTick = 256;
+
+private:
+  /** Adds the fast array item of a component */
+  void AddComponent(UStatusComponent* Component);
+
+  /** Player this manager replicates to */
+  APlayerController* GetViewer() const;
+
+  /** Adds or removes the item of a component given the player's view */
+  void UpdateRelevancy(UStatusComponent* Component, const APlayerController* Viewer, const FVector& ViewLocation);
+
+
+  /** Replicated statuses */
+  UPROPERTY(Replicated)
+  FStatusReplicationArray StatusItems;
+
+  /** Server only: item index of every replicated component */
+  TMap<TObjectKey<UStatusComponent>, int32> ItemIndexByComponent;
+
+  /** Server only: indices of the items waiting to be sent, so the tick never visits idle items */
+  TArray<int32> PendingItems;
+
+  /** Server only: next component of the world status store whose relevancy is checked */
+  int32 RelevancyCursor = 0;
+};
@@ -0,0 +1,195 @@
+#include "StatusSnapshot.h"
+#include "StatusComponent.h"
+#include "StatusWorldSubsystem.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Algo/BinarySearch.h"
+#include "Hash/CityHash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+// Reader
+FStatusSnapshotReader::~FStatusSnapshotReader()
+{
+   // The region must be released before its file
+   MappedRegion.Reset();
+   MappedFile.Reset();
+}
+
+bool FStatusSnapshotReader::Open(const FString& FilePath)
+{
+   Records = {};
+   RemainingTimes = {};
+   MappedRegion.Reset();
+   MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+   if (!MappedFile || MappedFile->GetFileSize() < static_cast<int64>(sizeof(FStatusSnapshotHeader))) return false;
+
+   MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+   if (!MappedRegion) return false;
+
+   return Open(MakeArrayView(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize())));
+}
+
+bool FStatusSnapshotReader::Open(TConstArrayView<uint8> Data)
+{
+   Records = {};
+   RemainingTimes = {};
+   if (Data.Num() < static_cast<int32>(sizeof(FStatusSnapshotHeader))) return false;
+
+   const FStatusSnapshotHeader* Header = reinterpret_cast<const FStatusSnapshotHeader*>(Data.GetData());
+   if (Header->Magic != FStatusSnapshotHeader::ExpectedMagic || Header->Version != FStatusSnapshotHeader::CurrentVersion) return false;
+
+   const int64 RecordsSize = static_cast<int64>(Header->NumRecords) * sizeof(FStatusSnapshotRecord);
+   const int64 TimesSize = static_cast<int64>(Header->NumRemainingTimes) * sizeof(float);
+   if (sizeof(FStatusSnapshotHeader) + RecordsSize + TimesSize > static_cast<uint64>(Data.Num())) return false;
+
+   const uint8* RecordData = Data.GetData() + sizeof(FStatusSnapshotHeader);
+   Records = MakeArrayView(reinterpret_cast<const FStatusSnapshotRecord*>(RecordData), static_cast<int32>(Header->NumRecords));
+   RemainingTimes = MakeArrayView(reinterpret_cast<const float*>(RecordData + RecordsSize), static_cast<int32>(Header->NumRemainingTimes));
+   return true;
+}
+
+const FStatusSnapshotRecord* FStatusSnapshotReader::Find(uint64 SnapshotId) const
+{
+   const int32 Index = Algo::LowerBoundBy(Records, SnapshotId, &FStatusSnapshotRecord::SnapshotId);
+   return Index < Records.Num() && Records[Index].SnapshotId == SnapshotId ? &Records[Index] : nullptr;
+}
+
+TConstArrayView<float> FStatusSnapshotReader::GetRemainingTimes(const FStatusSnapshotRecord& Record) const
+{
+   const int32 NumTimes = FMath::CountBits(Record.TimedMask);
+   if (static_cast<int64>(Record.FirstRemainingTime) + NumTimes > RemainingTimes.Num()) return {};
+   return RemainingTimes.Slice(Record.FirstRemainingTime, NumTimes);
+}
+
+// Snapshot
+uint64 FStatusSnapshot::GetSnapshotId(const UStatusComponent* Component)
+{
+   const AActor* Actor = Component ? Component->GetOwner() : nullptr;
+   if (!Actor) return 0;
+
+   // 0 is reserved for components that are not saved
+   if (Component->PersistentId.IsValid())
+   {
+       return FMath::Max<uint64>(CityHash64(reinterpret_cast<const char*>(&Component->PersistentId), sizeof(FGuid)), 1);
+   }
+   if (Actor->HasAnyFlags(RF_WasLoaded) || Actor->IsNetStartupActor())
+   {
+       // The PIE prefix changes between sessions, the rest of the path is stable for placed and streamed actors.
+       // The component's own path is hashed so two status components of one actor get different ids.
+       const FString PathName = UWorld::RemovePIEPrefix(Component->GetPathName());
+       return FMath::Max<uint64>(CityHash64(reinterpret_cast<const char*>(*PathName), PathName.Len() * sizeof(TCHAR)), 1);
+   }
+   return 0;
+}
+
+void FStatusSnapshot::Capture(const UStatusWorldSubsystem& StatusStore, TArray<uint8>& OutData)
+{
+   const FStatusExpiryScheduler& Scheduler = StatusStore.GetExpiryScheduler();
+   const TConstArrayView<uint8> PackedFlags = StatusStore.GetPackedFlags();
+   const double Now = StatusStore.GetWorld()->GetTimeSeconds();
+
+   TArray<FStatusSnapshotRecord> Records;
+   Records.Reserve(PackedFlags.Num());
+   for (int32 StoreIndex = 0; StoreIndex < PackedFlags.Num(); ++StoreIndex)
+   {
+       // Spawned actors without a persistent id could not be matched on restore
+       const uint64 SnapshotId = GetSnapshotId(StatusStore.GetComponentAt(StoreIndex));
+       if (SnapshotId == 0) continue;
+
+       FStatusSnapshotRecord& Record = Records.AddDefaulted_GetRef();
+       Record.SnapshotId = SnapshotId;
+       Record.FirstRemainingTime = static_cast<uint32>(StoreIndex);
+       Record.Flags = PackedFlags[StoreIndex];
+       Record.TimedMask = Scheduler.GetTimedMask(StoreIndex) & Record.Flags;
+       Record.Reserved = 0;
+   }
+
+   // Sorted records let the restore find each component with a binary search
+   Records.Sort([](const FStatusSnapshotRecord& A, const FStatusSnapshotRecord& B) { return A.SnapshotId < B.SnapshotId; });
+
+   // FirstRemainingTime holds the store index until the times are laid out in record order
+   TArray<float> RemainingTimes;
+   for (FStatusSnapshotRecord& Record : Records)
+   {
+       const int32 StoreIndex = static_cast<int32>(Record.FirstRemainingTime);
+       Record.FirstRemainingTime = static_cast<uint32>(RemainingTimes.Num());
+       for (uint32 Bits = Record.TimedMask; Bits; Bits &= Bits - 1)
+       {
+           const int32 BitIndex = FMath::CountTrailingZeros(Bits);
+           RemainingTimes.Add(static_cast<float>(Scheduler.GetExpireTime(StoreIndex, BitIndex) - Now));
+       }
+   }
+
+   FStatusSnapshotHeader Header;
+   Header.NumRecords = static_cast<uint32>(Records.Num());
+   Header.NumRemainingTimes = static_cast<uint32>(RemainingTimes.Num());
+
+   OutData.Reset(sizeof(Header) + Records.Num() * sizeof(FStatusSnapshotRecord) + RemainingTimes.Num() * sizeof(float));
+   OutData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+   OutData.Append(reinterpret_cast<const uint8*>(Records.GetData()), Records.Num() * sizeof(FStatusSnapshotRecord));
+   OutData.Append(reinterpret_cast<const uint8*>(RemainingTimes.GetData()), RemainingTimes.Num() * sizeof(float));
+}
+
+bool FStatusSnapshot::SaveToFile(const UStatusWorldSubsystem& StatusStore, const FString& FilePath)
+{
+   TArray<uint8> Data;
+   Capture(StatusStore, Data);
+   return FFileHelper::SaveArrayToFile(Data, *FilePath);
+}
+
+int32 FStatusSnapshot::Restore(UStatusWorldSubsystem& StatusStore, const FStatusSnapshotReader& Snapshot)
+{
+   if (Snapshot.GetRecords().IsEmpty()) return 0;
+
+   // Held back events are sent when the scope ends, once per component
+   FStatusEventBatchScope EventBatch(StatusStore);
+
+   int32 NumRestored = 0;
+   for (int32 StoreIndex = 0; StoreIndex < StatusStore.Num(); ++StoreIndex)
+   {
+       UStatusComponent* Component = StatusStore.GetComponentAt(StoreIndex);
+       const uint64 SnapshotId = GetSnapshotId(Component);
+       if (SnapshotId == 0) continue;
+
+       if (const FStatusSnapshotRecord* Record = Snapshot.Find(SnapshotId))
+       {
+           Component->RestoreStatusState(Record->Flags, Record->TimedMask, Snapshot.GetRemainingTimes(*Record));
+           ++NumRestored;
+       }
+   }
+   return NumRestored;
+}
+
+// Console commands
+static FString GetStatusSnapshotPath(const TArray<FString>& Args)
+{
+   return Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("StatusSnapshot.bin");
+}
+
+static FAutoConsoleCommandWithWorldAndArgs StatusSnapshotSaveCommand(
+   TEXT("Status.Snapshot.Save"),
+   TEXT("Saves the status of every component of the world. Optional argument: output file."),
+   FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+   {
+       const UStatusWorldSubsystem* StatusStore = World ? World->GetSubsystem<UStatusWorldSubsystem>() : nullptr;
+       const FString FilePath = GetStatusSnapshotPath(Args);
+       if (StatusStore && FStatusSnapshot::SaveToFile(*StatusStore, FilePath))
+       {
+           UE_LOG(LogTemp, Log, TEXT("Saved %d status components to %s"), StatusStore->Num(), *FilePath);
+       }
+   }));
+
+static FAutoConsoleCommandWithWorldAndArgs StatusSnapshotLoadCommand(
+   TEXT("Status.Snapshot.Load"),
+   TEXT("Restores the status of every component of the world. Optional argument: snapshot file."),
+   FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+   {
+       UStatusWorldSubsystem* StatusStore = World ? World->GetSubsystem<UStatusWorldSubsystem>() : nullptr;
+       const FString FilePath = GetStatusSnapshotPath(Args);
+       FStatusSnapshotReader Snapshot;
+       if (StatusStore && Snapshot.Open(FilePath))
+       {
+           UE_LOG(LogTemp, Log, TEXT("Restored %d status components from %s"), FStatusSnapshot::Restore(*StatusStore, Snapshot), *FilePath);
+       }
+   }));
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UStatusComponent;
+class UStatusWorldSubsystem;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Header at the start of every snapshot, followed by the records sorted by snapshot id and the remaining times
+ */
+struct FStatusSnapshotHeader
+{
+  static constexpr uint32 ExpectedMagic = 0x504E5353; // "SSNP"
+  /** 2: records are keyed by component instead of by actor */
+  static constexpr uint32 CurrentVersion = 2;
+
+  uint32 Magic = ExpectedMagic;
+  uint32 Version = CurrentVersion;
+  uint32 NumRecords = 0;
+  uint32 NumRemainingTimes = 0;
+};
+static_assert(sizeof(FStatusSnapshotHeader) == 16, "The header keeps the records 8 byte aligned");
+
+/**
+ * Saved status of one component
+ */
+struct FStatusSnapshotRecord
+{
+  /** Stable id of the component, see FStatusSnapshot::GetSnapshotId */
+  uint64 SnapshotId;
+
+  /** Index of the first remaining time of this record, one entry per bit of TimedMask in bit order */
+  uint32 FirstRemainingTime;
+
+  uint8 Flags;
+  uint8 TimedMask;
+  uint16 Reserved;
+};
+static_assert(sizeof(FStatusSnapshotRecord) == 16, "Snapshot records are written and mapped as raw 16 byte entries");
+
+/**
+ * StatusSnapshotReader - Read-only view of a snapshot, either in memory or memory-mapped from a file
+ * The records are used in place, nothing is copied or deserialized.
+ */
+class GAME_API FStatusSnapshotReader
+{
+public:
+  ~FStatusSnapshotReader();
+
+  /**
+   * Maps a snapshot file
+   * @param FilePath - Snapshot written by FStatusSnapshot
+   * @return True if the file is a valid snapshot
+   */
+  bool Open(const FString& FilePath);
+
+  /**
+   * Views a snapshot in memory, the data must outlive the reader
+   * @param Data - Snapshot written by FStatusSnapshot::Capture
+   * @return True if the data is a valid snapshot
+   */
+  bool Open(TConstArrayView<uint8> Data);
+
+  /** Records of the snapshot, sorted by snapshot id */
+  FORCEINLINE TConstArrayView<FStatusSnapshotRecord> GetRecords() const { return Records; }
+
+  /**
+   * Finds the record of a component
+   * @param SnapshotId - Stable id of the component, see FStatusSnapshot::GetSnapshotId
+   * @return The record, null if the component is not in the snapshot
+   */
+  const FStatusSnapshotRecord* Find(uint64 SnapshotId) const;
+
+  /** Remaining times of the timed flags of a record, one per bit of its TimedMask */
+  TConstArrayView<float> GetRemainingTimes(const FStatusSnapshotRecord& Record) const;
+
+private:
+  TUniquePtr<IMappedFileHandle> MappedFile;
+  TUniquePtr<IMappedFileRegion> MappedRegion;
+  TConstArrayView<FStatusSnapshotRecord> Records;
+  TConstArrayView<float> RemainingTimes;
+};
+
+/**
+ * StatusSnapshot - Bulk save and restore of every status component of a world
+ * A snapshot is one tightly packed, versioned block: header, 16 byte records sorted by snapshot id, then the
+ * remaining times of the timed flags. It replaces per-property SaveGame serialization for autosaves and
+ * level streaming, and can be restored straight from a memory-mapped file.
+ */
+class GAME_API FStatusSnapshot
+{
+public:
+  /**
+   * Returns an id of a component that stays the same between sessions and in PIE
+   * Components with a PersistentId use it. Otherwise only components of actors loaded with their level have an id, the
+   * hash of the component's path name, which also tells apart several status components of one actor. Names of spawned
+   * actors depend on the spawn order, so their components are skipped unless they have a PersistentId.
+   * @param Component - Status component to identify
+   * @return Stable id, 0 if the component has none and is not saved
+   */
+  static uint64 GetSnapshotId(const UStatusComponent* Component);
+
+  /**
+   * Writes the status of every registered component of a store
+   * @param StatusStore - Store of the world to save
+   * @param OutData - Receives the snapshot
+   */
+  static void Capture(const UStatusWorldSubsystem& StatusStore, TArray<uint8>& OutData);
+
+  /**
+   * Captures a store and writes the snapshot to a file
+   * @param StatusStore - Store of the world to save
+   * @param FilePath - File to create
+   * @return True if the file was written
+   */
+  static bool SaveToFile(const UStatusWorldSubsystem& StatusStore, const FString& FilePath);
+
+  /**
+   * Restores every registered component found in a snapshot
+   * Events are held back until every component is restored, then each component sends one change event.
+   * @param StatusStore - Store of the world to restore
+   * @param Snapshot - Snapshot to read
+   * @return Number of restored components
+   */
+  static int32 Restore(UStatusWorldSubsystem& StatusStore, const FStatusSnapshotReader& Snapshot);
+};
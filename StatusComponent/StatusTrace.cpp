@@ -0,0 +1,61 @@
+#include "StatusTrace.h"
+#include "Trace/Trace.inl"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+
+UE_TRACE_CHANNEL_DEFINE(StatusChannel)
+
+UE_TRACE_EVENT_BEGIN(Status, Transition)
+   UE_TRACE_EVENT_FIELD(uint64, Cycle)
+   UE_TRACE_EVENT_FIELD(uint32, ComponentId)
+   UE_TRACE_EVENT_FIELD(uint8, OldFlags)
+   UE_TRACE_EVENT_FIELD(uint8, NewFlags)
+   UE_TRACE_EVENT_FIELD(uint8, Cause)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Status, FrameCounts)
+   UE_TRACE_EVENT_FIELD(uint64, Cycle)
+   UE_TRACE_EVENT_FIELD(int32, Queries)
+   UE_TRACE_EVENT_FIELD(int32, Transitions)
+UE_TRACE_EVENT_END()
+
+TRACE_DECLARE_INT_COUNTER(StatusQueries, TEXT("Status/Queries"));
+TRACE_DECLARE_INT_COUNTER(StatusTransitions, TEXT("Status/Transitions"));
+
+std::atomic<int32> FStatusTrace::NumQueries{ 0 };
+std::atomic<int32> FStatusTrace::NumTransitions{ 0 };
+
+void FStatusTrace::OutputTransition(uint32 ComponentId, uint8 OldFlags, uint8 NewFlags, EStatusChangeCause Cause)
+{
+   NumTransitions.fetch_add(1, std::memory_order_relaxed);
+
+   UE_TRACE_LOG(Status, Transition, StatusChannel)
+       << Transition.Cycle(FPlatformTime::Cycles64())
+       << Transition.ComponentId(ComponentId)
+       << Transition.OldFlags(OldFlags)
+       << Transition.NewFlags(NewFlags)
+       << Transition.Cause(static_cast<uint8>(Cause));
+}
+
+void FStatusTrace::OutputFrameCounters()
+{
+   if (!IsEnabled()) return;
+
+   const int32 Queries = NumQueries.exchange(0, std::memory_order_relaxed);
+   const int32 Transitions = NumTransitions.exchange(0, std::memory_order_relaxed);
+
+   UE_TRACE_LOG(Status, FrameCounts, StatusChannel)
+       << FrameCounts.Cycle(FPlatformTime::Cycles64())
+       << FrameCounts.Queries(Queries)
+       << FrameCounts.Transitions(Transitions);
+
+   TRACE_COUNTER_SET(StatusQueries, Queries);
+   TRACE_COUNTER_SET(StatusTransitions, Transitions);
+}
+
+// The counters are process wide, publishing them from a world tick would split a frame between PIE server and client worlds
+static FDelayedAutoRegisterHelper GStatusTraceFrameCountersRegistration(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+{
+   FCoreDelegates::OnEndFrame.AddStatic(&FStatusTrace::OutputFrameCounters);
+});
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Trace.h"
+#include <atomic>
+
+enum class EStatusChangeCause : uint8;
+
+UE_TRACE_CHANNEL_EXTERN(StatusChannel, GAME_API)
+
+/**
+ * StatusTrace - Unreal Insights channel for status transitions and query counts
+ * Every committed transition is sent as a compact Status.Transition event, the number of flag queries and transitions
+ * of every world is sent once per engine frame as a Status.FrameCounts event.
+ * Enabled with -trace=status (or "Trace.Enable Status" at runtime). The same numbers are also set on the Status/Queries
+ * and Status/Transitions counters, which need the counters channel as well: -trace=status,counters.
+ * While the channel is off, every hook costs one branch on the channel state.
+ */
+struct GAME_API FStatusTrace
+{
+  /** True while the Status channel is traced */
+  static FORCEINLINE bool IsEnabled()
+  {
+#if UE_TRACE_ENABLED
+    return UE_TRACE_CHANNELEXPR_IS_ENABLED(StatusChannel);
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * Sends a transition event
+   * @param ComponentId - Status component id of the component
+   * @param OldFlags - Flags before the change
+   * @param NewFlags - Flags after the change
+   * @param Cause - Operation that caused the change
+   */
+  static FORCEINLINE void TraceTransition(uint32 ComponentId, uint8 OldFlags, uint8 NewFlags, EStatusChangeCause Cause)
+  {
+    if (IsEnabled())
+    {
+      OutputTransition(ComponentId, OldFlags, NewFlags, Cause);
+    }
+  }
+
+  /** Counts one flag query for this frame, callable from any thread */
+  static FORCEINLINE void CountQuery()
+  {
+    if (IsEnabled())
+    {
+      NumQueries.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  /** Publishes the counters of the frame and resets them, called at the end of every engine frame */
+  static void OutputFrameCounters();
+
+private:
+  static void OutputTransition(uint32 ComponentId, uint8 OldFlags, uint8 NewFlags, EStatusChangeCause Cause);
+
+  static std::atomic<int32> NumQueries;
+  static std::atomic<int32> NumTransitions;
+};
@@ -0,0 +1,74 @@
+#include "StatusTransitionRuleSet.h"
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(StatusTransitionRuleSet)
+
+namespace StatusTransitionRuleSet
+{
+   /** Upper bound of closure passes, rules that keep undoing each other stop there */
+   static constexpr int32 MaxClosurePasses = 8;
+}
+
+UStatusTransitionRuleSet::UStatusTransitionRuleSet()
+{
+   // Without rules every change resolves to itself
+   for (int32 Flags = 0; Flags < 256; ++Flags)
+   {
+       ClosureTable[Flags] = static_cast<uint8>(Flags);
+   }
+}
+
+void UStatusTransitionRuleSet::PostLoad()
+{
+   Super::PostLoad();
+   CompileRules();
+}
+
+#if WITH_EDITOR
+void UStatusTransitionRuleSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+   Super::PostEditChangeProperty(PropertyChangedEvent);
+   CompileRules();
+}
+#endif
+
+void UStatusTransitionRuleSet::CompileRules()
+{
+   using namespace StatusTransitionRuleSet;
+
+   for (int32 Mask = 0; Mask < 256; ++Mask)
+   {
+       uint8 Blocked = 0;
+       for (const FStatusTransitionRule& Rule : Rules)
+       {
+           // A rule without trigger flags would match every mask, such as a freshly added row
+           if (Rule.WhenFlags != 0 && (Mask & Rule.WhenFlags) == Rule.WhenFlags)
+           {
+               Blocked |= Rule.BlockedFlags;
+           }
+       }
+       BlockTable[Mask] = Blocked;
+
+       // Implications can activate other rules, so apply every rule until the flags stop changing
+       uint8 Flags = static_cast<uint8>(Mask);
+       for (int32 Pass = 0; Pass < MaxClosurePasses; ++Pass)
+       {
+           uint8 Implied = 0;
+           uint8 Excluded = 0;
+           for (const FStatusTransitionRule& Rule : Rules)
+           {
+               if (Rule.WhenFlags != 0 && (Flags & Rule.WhenFlags) == Rule.WhenFlags)
+               {
+                   Implied |= Rule.ImpliedFlags;
+                   Excluded |= Rule.ExcludedFlags;
+               }
+           }
+
+           const uint8 NextFlags = (Flags | Implied) & ~Excluded;
+           if (NextFlags == Flags) break;
+           Flags = NextFlags;
+       }
+       ClosureTable[Mask] = Flags;
+   }
+
+   CompiledNumRules = Rules.Num();
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "StatusTransitionRuleSet.generated.h"
+
+/**
+ * What happens to the other flags while a set of flags is present
+ */
+USTRUCT(BlueprintType)
+struct FStatusTransitionRule
+{
+  GENERATED_BODY()
+
+  /** The rule is active while all of these flags are present, rules without any flag here are ignored */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 WhenFlags = 0;
+
+  /** Flags added with them */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 ImpliedFlags = 0;
+
+  /** Flags removed when they are set */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 ExcludedFlags = 0;
+
+  /** Flags that cannot be added while they are present */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status", meta = (Bitmask, BitmaskEnum = "EStatusFlags"))
+  uint8 BlockedFlags = 0;
+};
+
+/**
+ * StatusTransitionRuleSet - Data asset with the implication, exclusion and block rules between status flags
+ * The rules are compiled into two 256 entry tables indexed by the 8-bit flag mask: the closure of the
+ * implications and exclusions of every mask, and the flags every mask blocks. Any change then resolves to its
+ * final flags with two lookups, so the component commits and broadcasts it once.
+ * Assets compile on load and on edit, sets built at runtime compile on first use from the game thread and whenever
+ * the number of rules changes. Code that edits existing rules in place must call CompileRules.
+ */
+UCLASS(BlueprintType)
+class GAME_API UStatusTransitionRuleSet : public UDataAsset
+{
+  GENERATED_BODY()
+
+public:
+  UStatusTransitionRuleSet();
+
+  virtual void PostLoad() override;
+#if WITH_EDITOR
+  virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+  /**
+   * Applies the rules to a change of flags
+   * Flags blocked by the old flags are not added, then implications and exclusions are applied.
+   * Blocks win over implications, a blocked flag is never added by an implied one.
+   * Safe to call from any thread, the tables only change when the rules are compiled. Other threads use the tables
+   * as last compiled, only the game thread compiles pending rules.
+   * @param OldFlags - Flags before the change
+   * @param RequestedFlags - Flags the change asks for
+   * @return The flags after the change
+   */
+  FORCEINLINE uint8 ResolveTransition(uint8 OldFlags, uint8 RequestedFlags) const
+  {
+    ConditionalCompileRules();
+    const uint8 Blocked = BlockTable[OldFlags];
+    const uint8 Resolved = ClosureTable[RequestedFlags & ~(Blocked & ~OldFlags)];
+    return Resolved & ~(Blocked & ~OldFlags);
+  }
+
+  /** Flags with the implications and exclusions applied */
+  FORCEINLINE uint8 GetClosure(uint8 Flags) const
+  {
+    ConditionalCompileRules();
+    return ClosureTable[Flags];
+  }
+
+  /** Flags that cannot be added while the given flags are present */
+  FORCEINLINE uint8 GetBlockedFlags(uint8 Flags) const
+  {
+    ConditionalCompileRules();
+    return BlockTable[Flags];
+  }
+
+  /** Rebuilds the closure and block tables, call it after editing Rules from code */
+  UFUNCTION(BlueprintCallable, Category = "Status")
+  void CompileRules();
+
+  /** Rules of the set */
+  UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Status")
+  TArray<FStatusTransitionRule> Rules;
+
+private:
+  /** Compiles the rules on the game thread if they were never compiled or rules were added or removed since */
+  FORCEINLINE void ConditionalCompileRules() const
+  {
+    if (CompiledNumRules != Rules.Num() && IsInGameThread())
+    {
+      const_cast<UStatusTransitionRuleSet*>(this)->CompileRules();
+    }
+  }
+
+  /** Number of rules at the last compilation, INDEX_NONE until the first one */
+  int32 CompiledNumRules = INDEX_NONE;
+
+  /** Final flags for every requested mask, identity until compiled */
+  uint8 ClosureTable[256];
+
+  /** Flags blocked by every mask */
+  uint8 BlockTable[256] = {};
+};
@@ -0,0 +1,322 @@
+#include "StatusWorldSubsystem.h"
+#include "StatusComponent.h"
+#include "StatusReplicationManager.h"
+#include "StatusTrace.h"
+#include "StatusDebugOverlay.h"
+#include "Debug/DebugDrawService.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+
+#if PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#endif
+
+#include UE_INLINE_GENERATED_CPP_BY_NAME(StatusWorldSubsystem)
+
+void UStatusWorldSubsystem::Tick(float DeltaTime)
+{
+   Super::Tick(DeltaTime);
+
+   if (ExpiryScheduler.NumPending() == 0) return;
+
+   ExpiryScheduler.CollectExpired(GetWorld()->GetTimeSeconds(), ExpiredScratch);
+   if (ExpiredScratch.Num() == 0) return;
+
+   // Resolve components first, listeners of the removals may unregister components and reorder the store
+   TArray<TPair<TWeakObjectPtr<UStatusComponent>, uint8>, TInlineAllocator<32>> Expired;
+   Expired.Reserve(ExpiredScratch.Num());
+   for (const TPair<int32, uint8>& Pair : ExpiredScratch)
+   {
+       Expired.Emplace(Components[Pair.Key], Pair.Value);
+   }
+
+   for (const TPair<TWeakObjectPtr<UStatusComponent>, uint8>& Pair : Expired)
+   {
+       if (UStatusComponent* Component = Pair.Key.Get())
+       {
+           Component->ExpireStatusFlags(Pair.Value);
+       }
+   }
+}
+
+TStatId UStatusWorldSubsystem::GetStatId() const
+{
+   RETURN_QUICK_DECLARE_CYCLE_STAT(UStatusWorldSubsystem, STATGROUP_Tickables);
+}
+
+void UStatusWorldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+   Super::OnWorldBeginPlay(InWorld);
+
+   // Clients receive their manager through replication, standalone games don't need one
+   const ENetMode NetMode = InWorld.GetNetMode();
+   if (NetMode == NM_DedicatedServer || NetMode == NM_ListenServer)
+   {
+       bReplicatingStatus = true;
+       for (FConstPlayerControllerIterator It = InWorld.GetPlayerControllerIterator(); It; ++It)
+       {
+           AddReplicationManager(It->Get());
+       }
+       PostLoginHandle = FGameModeEvents::GameModePostLoginEvent.AddUObject(this, &UStatusWorldSubsystem::HandlePostLogin);
+       LogoutHandle = FGameModeEvents::GameModeLogoutEvent.AddUObject(this, &UStatusWorldSubsystem::HandleLogout);
+   }
+
+#if !UE_BUILD_SHIPPING
+   if (!IsRunningDedicatedServer())
+   {
+       DebugDrawHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateUObject(this, &UStatusWorldSubsystem::DrawDebugOverlay));
+   }
+#endif
+}
+
+void UStatusWorldSubsystem::Deinitialize()
+{
+   FGameModeEvents::GameModePostLoginEvent.Remove(PostLoginHandle);
+   FGameModeEvents::GameModeLogoutEvent.Remove(LogoutHandle);
+#if !UE_BUILD_SHIPPING
+   if (DebugDrawHandle.IsValid())
+   {
+       UDebugDrawService::Unregister(DebugDrawHandle);
+       DebugDrawHandle.Reset();
+   }
+#endif
+   Super::Deinitialize();
+}
+
+void UStatusWorldSubsystem::AddReplicationManager(APlayerController* PlayerController)
+{
+   // Local players read the server's state directly
+   if (!PlayerController || PlayerController->IsLocalController()) return;
+
+   for (const AStatusReplicationManager* Manager : ReplicationManagers)
+   {
+       if (Manager && Manager->GetOwner() == PlayerController) return;
+   }
+
+   FActorSpawnParameters SpawnParams;
+   SpawnParams.Owner = PlayerController;
+   SpawnParams.ObjectFlags |= RF_Transient;
+   SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+   AStatusReplicationManager* Manager = GetWorld()->SpawnActor<AStatusReplicationManager>(SpawnParams);
+   if (!Manager) return;
+
+   ReplicationManagers.Add(Manager);
+   for (UStatusComponent* Component : ReplicatedComponents)
+   {
+       Manager->UpdateRelevancy(Component);
+   }
+}
+
+void UStatusWorldSubsystem::RemoveReplicationManager(AStatusReplicationManager* Manager)
+{
+   ReplicationManagers.RemoveSingleSwap(Manager, EAllowShrinking::No);
+}
+
+void UStatusWorldSubsystem::HandlePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+   if (GameMode && GameMode->GetWorld() == GetWorld())
+   {
+       AddReplicationManager(NewPlayer);
+   }
+}
+
+void UStatusWorldSubsystem::HandleLogout(AGameModeBase* GameMode, AController* Exiting)
+{
+   if (!GameMode || GameMode->GetWorld() != GetWorld()) return;
+
+   // Destroying the manager removes it from the list through its EndPlay
+   TArray<TObjectPtr<AStatusReplicationManager>> Managers = ReplicationManagers;
+   for (AStatusReplicationManager* Manager : Managers)
+   {
+       if (Manager && Manager->GetOwner() == Exiting)
+       {
+           Manager->Destroy();
+       }
+   }
+}
+
+void UStatusWorldSubsystem::AddReplicatedComponent(UStatusComponent* Component)
+{
+   check(Component && bReplicatingStatus);
+   if (Component->StatusReplicationIndex != INDEX_NONE) return;
+
+   Component->StatusReplicationIndex = ReplicatedComponents.Add(Component);
+
+   // Players that already see the owner get its status right away instead of on the next relevancy pass
+   for (AStatusReplicationManager* Manager : ReplicationManagers)
+   {
+       Manager->UpdateRelevancy(Component);
+   }
+}
+
+void UStatusWorldSubsystem::RemoveReplicatedComponent(UStatusComponent* Component)
+{
+   check(Component);
+   const int32 ReplicationIndex = Component->StatusReplicationIndex;
+   if (!ReplicatedComponents.IsValidIndex(ReplicationIndex) || ReplicatedComponents[ReplicationIndex] != Component) return;
+
+   const int32 LastIndex = ReplicatedComponents.Num() - 1;
+   if (ReplicationIndex != LastIndex)
+   {
+       ReplicatedComponents[LastIndex]->StatusReplicationIndex = ReplicationIndex;
+   }
+   ReplicatedComponents.RemoveAtSwap(ReplicationIndex, 1, EAllowShrinking::No);
+   Component->StatusReplicationIndex = INDEX_NONE;
+
+   for (AStatusReplicationManager* Manager : ReplicationManagers)
+   {
+       Manager->RemoveComponent(Component);
+   }
+}
+
+void UStatusWorldSubsystem::MarkReplicationDirty(UStatusComponent* Component)
+{
+   for (AStatusReplicationManager* Manager : ReplicationManagers)
+   {
+       Manager->MarkComponentDirty(Component);
+   }
+}
+
+void UStatusWorldSubsystem::DrawDebugOverlay(UCanvas* Canvas, APlayerController* PlayerController)
+{
+   FStatusDebugOverlay::Draw(*this, Canvas, PlayerController);
+}
+
+int32 UStatusWorldSubsystem::RegisterStatusComponent(UStatusComponent* Component)
+{
+   check(Component);
+   if (Component->StatusStoreIndex != INDEX_NONE) return Component->StatusStoreIndex;
+
+   const int32 StoreIndex = PackedFlags.Add(Component->StatusFlags);
+   Components.Add(Component);
+   ExpiryScheduler.AddRow();
+   Component->StatusStoreIndex = StoreIndex;
+   return StoreIndex;
+}
+
+void UStatusWorldSubsystem::UnregisterStatusComponent(UStatusComponent* Component)
+{
+   check(Component);
+   const int32 StoreIndex = Component->StatusStoreIndex;
+   if (!Components.IsValidIndex(StoreIndex) || Components[StoreIndex] != Component) return;
+
+   // Keep the array dense: the last entry takes over the freed slot
+   const int32 LastIndex = PackedFlags.Num() - 1;
+   if (StoreIndex != LastIndex)
+   {
+       UStatusComponent* Moved = Components[LastIndex];
+       Moved->StatusStoreIndex = StoreIndex;
+   }
+   ExpiryScheduler.RemoveRowAtSwap(StoreIndex);
+   PackedFlags.RemoveAtSwap(StoreIndex, 1, EAllowShrinking::No);
+   Components.RemoveAtSwap(StoreIndex, 1, EAllowShrinking::No);
+   Component->StatusStoreIndex = INDEX_NONE;
+}
+
+void UStatusWorldSubsystem::EndEventBatch()
+{
+   check(EventBatchDepth > 0);
+   if (--EventBatchDepth > 0) return;
+
+   // Listeners may register or unregister components, so go through a copy
+   TArray<TObjectPtr<UStatusComponent>> BatchedComponents = Components;
+   for (UStatusComponent* Component : BatchedComponents)
+   {
+       if (IsValid(Component))
+       {
+           Component->FlushStatusEvents();
+       }
+   }
+}
+
+int32 UStatusWorldSubsystem::QueryMatchingIndices(int32 MustHaveFlags, int32 MustNotHaveFlags, TArray<int32>& OutIndices) const
+{
+   FStatusTrace::CountQuery();
+
+   OutIndices.Reset();
+
+   const uint8 MustHave = static_cast<uint8>(MustHaveFlags);
+   const uint8 MustNotHave = static_cast<uint8>(MustNotHaveFlags);
+
+   // A flag can't be both required and prohibited
+   if (MustHave & MustNotHave) return 0;
+
+   // An entry matches when (Flags & (MustHave | MustNotHave)) == MustHave,
+   // so every entry costs one AND and one byte compare
+   const uint8 Mask = MustHave | MustNotHave;
+   const uint8* Data = PackedFlags.GetData();
+   const int32 Count = PackedFlags.Num();
+   int32 Index = 0;
+
+#if PLATFORM_CPU_X86_FAMILY
+   // 16 entries per iteration, matching lanes are turned into a 16-bit mask
+   const __m128i MaskVector = _mm_set1_epi8(static_cast<char>(Mask));
+   const __m128i WantVector = _mm_set1_epi8(static_cast<char>(MustHave));
+   for (; Index + 16 <= Count; Index += 16)
+   {
+       const __m128i Flags = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Data + Index));
+       uint32 Matches = static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(Flags, MaskVector), WantVector)));
+       while (Matches)
+       {
+           OutIndices.Add(Index + static_cast<int32>(FMath::CountTrailingZeros(Matches)));
+           Matches &= Matches - 1;
+       }
+   }
+#elif PLATFORM_LITTLE_ENDIAN
+   // 8 entries per iteration packed in a 64-bit word (SWAR)
+   constexpr uint64 Low7Bits = 0x7F7F7F7F7F7F7F7Full;
+   const uint64 MaskWord = 0x0101010101010101ull * Mask;
+   const uint64 WantWord = 0x0101010101010101ull * MustHave;
+   for (; Index + 8 <= Count; Index += 8)
+   {
+       uint64 Word;
+       FMemory::Memcpy(&Word, Data + Index, sizeof(Word));
+
+       // Matching bytes become zero, then every zero byte is marked with its high bit
+       const uint64 Diff = (Word & MaskWord) ^ WantWord;
+       uint64 Matches = ~(((Diff & Low7Bits) + Low7Bits) | Diff | Low7Bits);
+       while (Matches)
+       {
+           OutIndices.Add(Index + static_cast<int32>(FMath::CountTrailingZeros64(Matches) >> 3));
+           Matches &= Matches - 1;
+       }
+   }
+#endif
+
+   for (; Index < Count; ++Index)
+   {
+       if ((Data[Index] & Mask) == MustHave)
+       {
+           OutIndices.Add(Index);
+       }
+   }
+
+   return OutIndices.Num();
+}
+
+void UStatusWorldSubsystem::FindComponentsMatching(int32 MustHaveFlags, int32 MustNotHaveFlags, TArray<UStatusComponent*>& OutComponents) const
+{
+   TArray<int32> Indices;
+   QueryMatchingIndices(MustHaveFlags, MustNotHaveFlags, Indices);
+
+   OutComponents.Reset(Indices.Num());
+   for (const int32 StoreIndex : Indices)
+   {
+       OutComponents.Add(Components[StoreIndex]);
+   }
+}
+
+void UStatusWorldSubsystem::FindActorsMatching(int32 MustHaveFlags, int32 MustNotHaveFlags, TArray<AActor*>& OutActors) const
+{
+   TArray<int32> Indices;
+   QueryMatchingIndices(MustHaveFlags, MustNotHaveFlags, Indices);
+
+   OutActors.Reset(Indices.Num());
+   for (const int32 StoreIndex : Indices)
+   {
+       if (AActor* Owner = Components[StoreIndex]->GetOwner())
+       {
+           OutActors.Add(Owner);
+       }
+   }
+}
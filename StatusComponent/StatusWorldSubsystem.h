@@ -0,0 +1,203 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StatusExpiryScheduler.h"
+#include "StatusWorldSubsystem.generated.h"
+
+class UStatusComponent;
+class AStatusReplicationManager;
+class UCanvas;
+class APlayerController;
+class AController;
+class AGameModeBase;
+
+/**
+ * StatusWorldSubsystem - World-level store for the status flags of every UStatusComponent
+ * Flags are kept in one contiguous byte array (one entry per component) so that queries such as
+ * "every character that is Injured but not Dead" run as a single vectorized pass instead of
+ * visiting thousands of components one by one.
+ * Components register themselves on BeginPlay and keep their index into the store.
+ * Unregistering swaps the last entry into the freed slot, so the array always stays densely packed.
+ * The subsystem also owns the expiry scheduler of timed flags and expires every due flag once per frame,
+ * and spawns one status replication manager per remote player on servers.
+ */
+UCLASS()
+class GAME_API UStatusWorldSubsystem : public UTickableWorldSubsystem
+{
+  GENERATED_BODY()
+
+public:
+  // FTickableGameObject Interface
+  virtual void Tick(float DeltaTime) override;
+  virtual TStatId GetStatId() const override;
+
+  // UWorldSubsystem Interface
+  virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+  virtual void Deinitialize() override;
+
+  /**
+   * Adds a component to the store
+   * @param Component - Component to register
+   * @return Index of the component inside the packed flag array
+   */
+  int32 RegisterStatusComponent(UStatusComponent* Component);
+
+  /**
+   * Removes a component from the store, moving the last entry into its slot
+   * @param Component - Component to unregister
+   */
+  void UnregisterStatusComponent(UStatusComponent* Component);
+
+  /** Mirrors the new flags of a registered component into the packed array */
+  FORCEINLINE void SetStoredFlags(int32 StoreIndex, uint8 NewFlags)
+  {
+    PackedFlags[StoreIndex] = NewFlags;
+  }
+
+  /**
+   * Collects the store indices of every component whose flags contain all MustHaveFlags and none of MustNotHaveFlags
+   * @param MustHaveFlags - Flags that must be present
+   * @param MustNotHaveFlags - Flags that must not be present
+   * @param OutIndices - Receives the matching store indices in ascending order
+   * @return Number of matching components
+   */
+  int32 QueryMatchingIndices(int32 MustHaveFlags, int32 MustNotHaveFlags, TArray<int32>& OutIndices) const;
+
+  /**
+   * Finds every registered status component that matches the given masks
+   * @param MustHaveFlags - Flags that must be present
+   * @param MustNotHaveFlags - Flags that must not be present
+   * @param OutComponents - Receives the matching components
+   */
+  UFUNCTION(BlueprintCallable, Category = "Status")
+  void FindComponentsMatching(
+      UPARAM(meta = (Bitmask, BitmaskEnum = "EStatusFlags")) int32 MustHaveFlags,
+      UPARAM(meta = (Bitmask, BitmaskEnum = "EStatusFlags")) int32 MustNotHaveFlags,
+      TArray<UStatusComponent*>& OutComponents
+  ) const;
+
+  /**
+   * Finds the owners of every registered status component that matches the given masks
+   * @param MustHaveFlags - Flags that must be present
+   * @param MustNotHaveFlags - Flags that must not be present
+   * @param OutActors - Receives the matching actors
+   */
+  UFUNCTION(BlueprintCallable, Category = "Status")
+  void FindActorsMatching(
+      UPARAM(meta = (Bitmask, BitmaskEnum = "EStatusFlags")) int32 MustHaveFlags,
+      UPARAM(meta = (Bitmask, BitmaskEnum = "EStatusFlags")) int32 MustNotHaveFlags,
+      TArray<AActor*>& OutActors
+  ) const;
+
+  /** Number of registered components */
+  FORCEINLINE int32 Num() const { return PackedFlags.Num(); }
+
+  /** Component stored at the given index */
+  FORCEINLINE UStatusComponent* GetComponentAt(int32 StoreIndex) const { return Components[StoreIndex]; }
+
+  /** Packed flags of every registered component, indexed by store index */
+  FORCEINLINE TConstArrayView<uint8> GetPackedFlags() const { return PackedFlags; }
+
+  /** Expiry times of timed flags, rows are indexed by store index */
+  FORCEINLINE FStatusExpiryScheduler& GetExpiryScheduler() { return ExpiryScheduler; }
+  FORCEINLINE const FStatusExpiryScheduler& GetExpiryScheduler() const { return ExpiryScheduler; }
+
+  /** True on servers, where registered components can replicate their status */
+  FORCEINLINE bool IsReplicatingStatus() const { return bReplicatingStatus; }
+
+  /**
+   * Registers a component for status replication, server only
+   * @param Component - Registered component whose owner replicates
+   */
+  void AddReplicatedComponent(UStatusComponent* Component);
+
+  /**
+   * Stops replicating a component to every player
+   * @param Component - Component to remove
+   */
+  void RemoveReplicatedComponent(UStatusComponent* Component);
+
+  /** Queues the status of a replicated component for sending to every player it is relevant to */
+  void MarkReplicationDirty(UStatusComponent* Component);
+
+  /** Components registered for replication, in no particular order */
+  FORCEINLINE TConstArrayView<TObjectPtr<UStatusComponent>> GetReplicatedComponents() const { return ReplicatedComponents; }
+
+  /** Replication managers of the remote players */
+  FORCEINLINE TConstArrayView<TObjectPtr<AStatusReplicationManager>> GetReplicationManagers() const { return ReplicationManagers; }
+
+  /** Forgets a replication manager that is being destroyed */
+  void RemoveReplicationManager(AStatusReplicationManager* Manager);
+
+  /** Holds back the change events of every component until EndEventBatch, calls can be nested */
+  FORCEINLINE void BeginEventBatch() { ++EventBatchDepth; }
+
+  /** Ends an event batch, the outermost call sends the held back events, one per changed component */
+  void EndEventBatch();
+
+  /** True while change events are held back */
+  FORCEINLINE bool IsBatchingEvents() const { return EventBatchDepth > 0; }
+
+private:
+  /** Debug draw callback of the status overlay, see FStatusDebugOverlay */
+  void DrawDebugOverlay(UCanvas* Canvas, APlayerController* PlayerController);
+
+  /** Registration of DrawDebugOverlay with the debug draw service */
+  FDelegateHandle DebugDrawHandle;
+
+  /** Spawns the replication manager of a remote player */
+  void AddReplicationManager(APlayerController* PlayerController);
+
+  void HandlePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+  void HandleLogout(AGameModeBase* GameMode, AController* Exiting);
+
+  FDelegateHandle PostLoginHandle;
+  FDelegateHandle LogoutHandle;
+
+  /** Nesting depth of event batches */
+  int32 EventBatchDepth = 0;
+
+  /** One manager per remote player, each replicates the statuses relevant to its player */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<AStatusReplicationManager>> ReplicationManagers;
+
+  /** Server only: components whose status replicates, each keeps its index in StatusReplicationIndex */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<UStatusComponent>> ReplicatedComponents;
+
+  bool bReplicatingStatus = false;
+
+  /** Pending expirations of timed flags for every registered component */
+  FStatusExpiryScheduler ExpiryScheduler;
+
+  /** Flags that expired this frame, reused between frames */
+  TArray<TPair<int32, uint8>> ExpiredScratch;
+
+  /** Status flags of every registered component, one byte per component */
+  TArray<uint8> PackedFlags;
+
+  /** Registered components, parallel to PackedFlags */
+  UPROPERTY(Transient)
+  TArray<TObjectPtr<UStatusComponent>> Components;
+};
+
+/**
+ * Holds back the status change events of a world for the lifetime of the scope, for bulk changes such as loading a save
+ */
+struct FStatusEventBatchScope
+{
+  explicit FStatusEventBatchScope(UStatusWorldSubsystem& InStatusStore)
+    : StatusStore(InStatusStore)
+  {
+    StatusStore.BeginEventBatch();
+  }
+
+  ~FStatusEventBatchScope()
+  {
+    StatusStore.EndEventBatch();
+  }
+
+private:
+  UStatusWorldSubsystem& StatusStore;
+};